@@ -14,6 +14,39 @@
  * @note The ESP-EDU have 4 analog inputs and 1 analog output, but the designated pin for 
  * the latter is shared with analog output 0 (CH0).
  *
+ * In continuous mode the ADC is sampled by DMA at sample_frec, in frames of frame_lenght
+ * samples. Each frame is unpacked into one of two buffers (ping-pong) and func_p is called
+ * from the ISR once per frame: the last complete frame can be read with
+ * AnalogInputReadContinuous() while the next one is being filled.
+ *
+ * In scan mode the channels of scan_list are converted one after the other, sample_frec
+ * times per second (the ADC runs at sample_frec * scan_lenght). Samples are de-interleaved
+ * by the ISR into a ring buffer per channel (buffer_lenght scans) and each scan gets a
+ * timestamp (esp_timer, us). The channels of a scan are apart by one ADC conversion
+ * (1 / (sample_frec * scan_lenght * oversampling)), so skew between channels is at most
+ * (scan_lenght - 1) / (sample_frec * scan_lenght * oversampling). Scans are read with
+ * AnalogInputReadScan().
+ *
+ * With oversampling (continuous and scan modes) the ADC converts oversampling times faster
+ * and the frame ISR decimates each channel to sample_frec with an integer boxcar (mean of
+ * oversampling conversions) or CIC (order 3, better aliasing rejection) filter. Output values
+ * keep ADC_OVERSAMPLING_FRAC fractional bits (raw * 16, up to 2 more effective bits with
+ * 16x, as uncorrelated noise is averaged), and are converted to mV with interpolation by
+ * AnalogInputConvert() / AnalogInputConvertFloat().
+ *
+ * Each initialized input gets a calibration table (mV of each of the 4096 raw codes) built
+ * from its eFuse calibration curve. Single reads are converted with it, and raw buffers of
+ * the continuous and scan modes are converted with AnalogInputConvert() or
+ * AnalogInputConvertFloat() (one table lookup per sample). With cali_nvs the tables are
+ * stored in NVS and read back on the next boots instead of built again. The driver never
+ * erases NVS: if it can't be initialized (e.g. ESP_ERR_NVS_NO_FREE_PAGES) the tables are
+ * built in RAM, and erasing the partition is left to the application.
+ *
+ * @note Single mode can't be used at the same time as continuous or scan modes (all use ADC 1).
+ *
+ * Host test against mocks of the ESP-IDF ADC, calibration and NVS APIs in
+ * test/test_analog_io_mcu.c (make run).
+ *
  * @author Albano Peñalva
  *
  * @section changelog
@@ -21,11 +54,16 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 24/02/2024 | Document creation		                         						|
+ * | 16/10/2026 | Continuous mode (DMA frames, double buffered)							|
+ * | 16/10/2026 | Scan mode (multi-channel, per channel ring buffers)					|
+ * | 16/10/2026 | Calibration tables (raw to mV), optionally stored in NVS				|
+ * | 16/10/2026 | Oversampling with boxcar / CIC decimation in the frame ISR			|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include "stdint.h"
+#include "stdbool.h"
 /*==================[macros]=================================================*/
 typedef enum adc_ch {
 	CH0 = 0,				/*!< Channel 0 */
@@ -37,9 +75,17 @@ typedef enum adc_ch {
 typedef enum adc_mode {
 	ADC_SINGLE,				/*!< Single read */
 	ADC_CONTINUOUS,			/*!< Continuous read */
+	ADC_SCAN,				/*!< Continuous read of several channels */
 } adc_mode_t;
 
+typedef enum adc_decimation {
+	ADC_DECIMATION_BOXCAR,	/*!< Mean of oversampling conversions */
+	ADC_DECIMATION_CIC,		/*!< CIC filter of order 3 */
+} adc_decimation_t;
+
 #define DAC	0    			/*!< DAC pin. Override CH0 declaration*/
+#define ADC_OVERSAMPLING_MAX	16	/*!< Maximum oversampling factor */
+#define ADC_OVERSAMPLING_FRAC	4	/*!< Fractional bits of oversampled values */
 /*==================[typedef]================================================*/
 /**
  * @brief Analog inputs config structure
@@ -47,10 +93,17 @@ typedef enum adc_mode {
  */
 typedef struct {			
 	adc_ch_t input;			/*!< Inputs: CH0, CH1, CH2, CH3 */
-	adc_mode_t mode;		/*!< Mode: single read or continuous read */
-	void *func_p;			/*!< Pointer to callback function for convertion end (only for continuous mode) */
-	void *param_p;			/*!< Pointer to callback function parameters (only for continuous mode) */
-	uint16_t sample_frec;	/*!< Sample frequency min: 20kHz - max: 2MHz (only for continuous mode)  */
+	adc_mode_t mode;		/*!< Mode: single read, continuous read or scan */
+	void *func_p;			/*!< Pointer to callback function for frame end, called from ISR (only for continuous and scan modes) */
+	void *param_p;			/*!< Pointer to callback function parameters (only for continuous and scan modes) */
+	uint32_t sample_frec;	/*!< Sample frequency min: 611 Hz - max: 83333 Hz (only for continuous mode). Scans per second in scan mode (sample_frec * scan_lenght in the same range) */
+	uint16_t frame_lenght;	/*!< Samples (scans in scan mode) per frame, after decimation, 0 for default: 256 / oversampling (only for continuous and scan modes) */
+	const adc_ch_t *scan_list;	/*!< Channels of each scan (each one once), in conversion order (only for scan mode) */
+	uint8_t scan_lenght;	/*!< Number of channels in scan_list: 1 to 4 (only for scan mode) */
+	uint16_t buffer_lenght;	/*!< Scans stored per channel, power of two >= frame_lenght, 0 for default: 1024 (only for scan mode) */
+	bool cali_nvs;			/*!< Store calibration tables in NVS (built only on first boot) */
+	uint8_t oversampling;	/*!< Conversions per output sample: 1 (or 0), 2, 4, 8 or 16; sample_frec * scan_lenght * oversampling in the ADC range (only for continuous and scan modes) */
+	adc_decimation_t decimation;	/*!< Decimation filter when oversampling: boxcar or CIC (only for continuous and scan modes) */
 } analog_input_config_t;	
 
 /*==================[external data declaration]==============================*/
@@ -59,6 +112,9 @@ typedef struct {
 /**
  * @brief Analog input initialization
  * 
+ * @note Continuous and scan modes share ADC 1 DMA: a new initialization in any of them
+ * stops and replaces the previous one (invalid configurations leave it unchanged)
+ * 
  * @param config Analog inputs config structure
  * @return null
  */
@@ -75,7 +131,7 @@ void AnalogOutputInit(void);
  * @brief Read single channel.
  * 
  * @param channel Channel selected
- * @param value Read variable pointer (in mV)
+ * @param value Read variable pointer (in mV, raw value if the calibration table couldn't be built)
  * @return null
  */
 void AnalogInputReadSingle(adc_ch_t channel, uint16_t *value);
@@ -95,12 +151,64 @@ void AnalogStartContinuous(adc_ch_t channel);
 void AnalogStopContinuous(adc_ch_t channel);
 
 /**
- * @brief 
+ * @brief Read the last complete frame of the continuous mode (raw values, with
+ * ADC_OVERSAMPLING_FRAC fractional bits when oversampling)
+ * 
+ * @note Must be called before the next frame is complete (e.g. from the task notified
+ * by func_p), otherwise the buffer being read is overwritten
  * 
  * @param channel Channel selected.
- * @param values Read variable array
+ * @param values Read variable array (of frame_lenght values)
+ * @return Number of values read (0 if no frame is complete yet)
+ */
+uint16_t AnalogInputReadContinuous(adc_ch_t channel, uint16_t *values);
+
+/**
+ * @brief Read the oldest unread scans of the scan mode (raw values, with
+ * ADC_OVERSAMPLING_FRAC fractional bits when oversampling)
+ * 
+ * @note If more than buffer_lenght scans are unread the oldest are lost (counted by
+ * AnalogInputScanOverruns()), also the ones overwritten by the ISR while being read: only
+ * complete scans are returned, so less than the available (even 0) can be read. Must be
+ * called from a single task.
+ * 
+ * @param values Array of scan_lenght pointers, one per channel in scan_list order, to arrays of lenght values
+ * @param timestamps Array of lenght scan timestamps (us, esp_timer_get_time() base), or NULL
+ * @param lenght Maximum number of scans to read
+ * @return Number of scans read
+ */
+uint16_t AnalogInputReadScan(uint16_t **values, int64_t *timestamps, uint16_t lenght);
+
+/**
+ * @brief Scans lost because they weren't read in time (scan mode)
+ * 
+ * @return Number of scans lost since initialization
+ */
+uint32_t AnalogInputScanOverruns(void);
+
+/**
+ * @brief Convert raw values of an input to mV with its calibration table
+ * 
+ * @param channel Input the values were read from
+ * @param raw Raw values array
+ * @param mv Converted values array (can be the same as raw)
+ * @param lenght Number of values
+ * @return true Values converted
+ * @return false Input has no calibration table (not initialized)
+ */
+bool AnalogInputConvert(adc_ch_t channel, const uint16_t *raw, uint16_t *mv, uint16_t lenght);
+
+/**
+ * @brief Convert raw values of an input to mV (float) with its calibration table
+ * 
+ * @param channel Input the values were read from
+ * @param raw Raw values array
+ * @param mv Converted values array
+ * @param lenght Number of values
+ * @return true Values converted
+ * @return false Input has no calibration table (not initialized)
  */
-void AnalogInputReadContinuous(adc_ch_t channel, uint16_t *values);
+bool AnalogInputConvertFloat(adc_ch_t channel, const uint16_t *raw, float *mv, uint16_t lenght);
 
 /**
  * @brief Digital-to-Analog convert.
@@ -0,0 +1,185 @@
+#ifndef RING_BUFFER_MCU_H
+#define RING_BUFFER_MCU_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Microcontroller Drivers microcontroller
+ ** @{ */
+/** \addtogroup Ring_Buffer Ring Buffer
+ ** @{ */
+
+/** \brief Lock-free single producer / single consumer sample ring buffer.
+ *
+ * Passes samples from an ISR (producer) to a task (consumer) without disabling
+ * interrupts: each index is written by one side only, and is published with release
+ * ordering after the samples (producer) or after they were read (consumer).
+ *
+ * Lenght must be a power of two: positions are free running indexes masked with
+ * lenght - 1. When the buffer is full new samples are dropped (never the ones the consumer
+ * may be reading) and counted as overruns.
+ *
+ * Functions are generated for each sample type, e.g. for float (F32):
+ *
+ * | Function                                   | Side     | Description                                          |
+ * |:-------------------------------------------|:---------|:-----------------------------------------------------|
+ * | RingBufferF32Init(rb, buffer, lenght)      | -        | Use buffer (lenght samples) as storage, false if lenght is not a power of two |
+ * | RingBufferF32Write(rb, value)              | producer | Store one sample, false if full (inline, ISR safe)    |
+ * | RingBufferF32WriteBlock(rb, values, n)     | producer | Store up to n samples, returns samples stored (inline, ISR safe) |
+ * | RingBufferF32Available(rb)                 | consumer | Samples ready to read                                |
+ * | RingBufferF32Read(rb, values, n)           | consumer | Copy and remove up to n samples, returns samples read |
+ * | RingBufferF32Peek(rb, span)                | consumer | Ready samples without copy: two contiguous spans (the second one after wrap around), returns samples ready |
+ * | RingBufferF32Consume(rb, n)                | consumer | Remove up to n samples (after Peek()), returns samples removed |
+ * | RingBufferF32Overruns(rb)                  | any      | Samples dropped since Init()                         |
+ *
+ * Types: ring_buffer_i16_t (I16, int16_t), ring_buffer_u16_t (U16, uint16_t) and
+ * ring_buffer_f32_t (F32, float), with spans ring_buffer_i16_span_t... Other types can be
+ * added with RING_BUFFER_DECLARE() here and RING_BUFFER_DEFINE() in ring_buffer_mcu.c.
+ *
+ * Host test with producer / consumer threads in test/test_ring_buffer_mcu.c (make run).
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+/*==================[macros]=================================================*/
+/**
+ * @brief Declare ring buffer type, span type and functions for a sample type
+ *
+ * @param name Lower case suffix of the types (ring_buffer_<name>_t)
+ * @param Name Suffix of the functions (RingBuffer<Name>Write()...)
+ * @param type Sample type
+ */
+#define RING_BUFFER_DECLARE(name, Name, type)																\
+typedef struct {																							\
+	type *buffer;				/*!< Samples storage */														\
+	uint32_t mask;				/*!< Lenght - 1 */															\
+	uint32_t write;				/*!< Samples written (only modified by producer) */							\
+	uint32_t read;				/*!< Samples read (only modified by consumer) */							\
+	uint32_t overruns;			/*!< Samples dropped because buffer was full (only modified by producer) */	\
+} ring_buffer_##name##_t;																					\
+																											\
+typedef struct {																							\
+	const type *data;			/*!< First sample of the span */											\
+	uint32_t lenght;			/*!< Samples in the span */													\
+} ring_buffer_##name##_span_t;																				\
+																											\
+bool RingBuffer##Name##Init(ring_buffer_##name##_t *rb, type *buffer, uint32_t lenght);					\
+uint32_t RingBuffer##Name##Available(ring_buffer_##name##_t *rb);											\
+uint32_t RingBuffer##Name##Read(ring_buffer_##name##_t *rb, type *values, uint32_t n);						\
+uint32_t RingBuffer##Name##Peek(ring_buffer_##name##_t *rb, ring_buffer_##name##_span_t span[2]);			\
+uint32_t RingBuffer##Name##Consume(ring_buffer_##name##_t *rb, uint32_t n);								\
+uint32_t RingBuffer##Name##Overruns(ring_buffer_##name##_t *rb);											\
+																											\
+static inline bool RingBuffer##Name##Write(ring_buffer_##name##_t *rb, type value){						\
+	uint32_t write = rb->write;																				\
+	/* Slot is free once the consumer published it was read */												\
+	if(write - __atomic_load_n(&rb->read, __ATOMIC_ACQUIRE) > rb->mask){									\
+		__atomic_store_n(&rb->overruns, rb->overruns + 1, __ATOMIC_RELAXED);								\
+		return false;																						\
+	}																										\
+	rb->buffer[write & rb->mask] = value;																	\
+	__atomic_store_n(&rb->write, write + 1, __ATOMIC_RELEASE);												\
+	return true;																							\
+}																											\
+																											\
+static inline uint32_t RingBuffer##Name##WriteBlock(ring_buffer_##name##_t *rb, const type *values, uint32_t n){ \
+	uint32_t write = rb->write;																				\
+	uint32_t space = rb->mask + 1 - (write - __atomic_load_n(&rb->read, __ATOMIC_ACQUIRE));					\
+	if(n > space){																							\
+		__atomic_store_n(&rb->overruns, rb->overruns + n - space, __ATOMIC_RELAXED);							\
+		n = space;																							\
+	}																										\
+	uint32_t pos = write & rb->mask;																		\
+	uint32_t first = rb->mask + 1 - pos;																	\
+	if(first > n){																							\
+		first = n;																							\
+	}																										\
+	memcpy(&rb->buffer[pos], values, first * sizeof(type));													\
+	memcpy(rb->buffer, &values[first], (n - first) * sizeof(type));											\
+	__atomic_store_n(&rb->write, write + n, __ATOMIC_RELEASE);												\
+	return n;																								\
+}
+
+/**
+ * @brief Define the (not inline) functions declared by RING_BUFFER_DECLARE()
+ */
+#define RING_BUFFER_DEFINE(name, Name, type)																\
+bool RingBuffer##Name##Init(ring_buffer_##name##_t *rb, type *buffer, uint32_t lenght){					\
+	if((lenght == 0) || ((lenght & (lenght - 1)) != 0)){													\
+		return false;																						\
+	}																										\
+	rb->buffer = buffer;																					\
+	rb->mask = lenght - 1;																					\
+	rb->write = 0;																							\
+	rb->read = 0;																							\
+	rb->overruns = 0;																						\
+	return true;																							\
+}																											\
+																											\
+uint32_t RingBuffer##Name##Available(ring_buffer_##name##_t *rb){											\
+	return __atomic_load_n(&rb->write, __ATOMIC_ACQUIRE) - rb->read;										\
+}																											\
+																											\
+uint32_t RingBuffer##Name##Peek(ring_buffer_##name##_t *rb, ring_buffer_##name##_span_t span[2]){			\
+	uint32_t available = RingBuffer##Name##Available(rb);													\
+	uint32_t pos = rb->read & rb->mask;																		\
+	uint32_t first = rb->mask + 1 - pos;																	\
+	if(first > available){																					\
+		first = available;																					\
+	}																										\
+	span[0].data = &rb->buffer[pos];																		\
+	span[0].lenght = first;																					\
+	span[1].data = rb->buffer;																				\
+	span[1].lenght = available - first;																		\
+	return available;																						\
+}																											\
+																											\
+uint32_t RingBuffer##Name##Consume(ring_buffer_##name##_t *rb, uint32_t n){								\
+	uint32_t available = RingBuffer##Name##Available(rb);													\
+	if(n > available){																						\
+		n = available;																						\
+	}																										\
+	/* Samples were read before the producer can overwrite them */											\
+	__atomic_store_n(&rb->read, rb->read + n, __ATOMIC_RELEASE);											\
+	return n;																								\
+}																											\
+																											\
+uint32_t RingBuffer##Name##Read(ring_buffer_##name##_t *rb, type *values, uint32_t n){						\
+	ring_buffer_##name##_span_t span[2];																	\
+	uint32_t available = RingBuffer##Name##Peek(rb, span);													\
+	if(n > available){																						\
+		n = available;																						\
+	}																										\
+	uint32_t first = (n < span[0].lenght) ? n : span[0].lenght;												\
+	memcpy(values, span[0].data, first * sizeof(type));														\
+	memcpy(&values[first], span[1].data, (n - first) * sizeof(type));										\
+	return RingBuffer##Name##Consume(rb, n);																\
+}																											\
+																											\
+uint32_t RingBuffer##Name##Overruns(ring_buffer_##name##_t *rb){											\
+	return __atomic_load_n(&rb->overruns, __ATOMIC_RELAXED);												\
+}
+
+/*==================[typedef]================================================*/
+RING_BUFFER_DECLARE(i16, I16, int16_t)
+RING_BUFFER_DECLARE(u16, U16, uint16_t)
+RING_BUFFER_DECLARE(f32, F32, float)
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* #ifndef RING_BUFFER_MCU_H */
+
+/*==================[end of file]============================================*/
@@ -10,22 +10,339 @@
  */
 
 /*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "analog_io_mcu.h"
+#include "esp_log.h"
+#include "esp_timer.h"
 #include "driver/gptimer.h"
 #include "driver/sdm.h"
 #include "esp_adc/adc_cali_scheme.h"
 #include "esp_adc/adc_oneshot.h"
 #include "esp_adc/adc_continuous.h"
+#include "nvs_flash.h"
+#include "nvs.h"
 /*==================[macros and definitions]=================================*/
 #define ADC_BITWIDTH 		SOC_ADC_DIGI_MAX_BITWIDTH	// 12 bit resolution
 #define ADC_ATTENUATION		ADC_ATTEN_DB_12				// 12dB attenuation (for 0-3,3V ADC range)
+#define ADC_INPUTS			4							// Analog inputs of the board (CH0 to CH3)
+#define ADC_FRAME_LENGHT	256							// Default conversions (of each channel) per frame (continuous and scan modes)
+#define ADC_BUFFER_LENGHT	1024						// Default scans stored per channel (scan mode)
+#define ADC_CALI_LENGHT		(1 << ADC_BITWIDTH)			// Calibration table entries (one per raw code)
+#define ADC_CALI_NAMESPACE	"analog_io"					// NVS namespace of calibration tables
+#define ADC_DECIM_ORDER_MAX	3							// Maximum order of decimation filters (CIC)
+#if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
+#define ADC_OUTPUT_TYPE		ADC_DIGI_OUTPUT_FORMAT_TYPE1
+#define ADC_GET_CHANNEL(p)	((p)->type1.channel)
+#define ADC_GET_DATA(p)		((p)->type1.data)
+#else
+#define ADC_OUTPUT_TYPE		ADC_DIGI_OUTPUT_FORMAT_TYPE2
+#define ADC_GET_CHANNEL(p)	((p)->type2.channel)
+#define ADC_GET_DATA(p)		((p)->type2.data)
+#endif
+#define TAG "analog_io"
+/**
+ * @brief Decimation filter of an input (CIC: boxcar is order 1)
+ */
+typedef struct {
+	uint32_t integrator[ADC_DECIM_ORDER_MAX];	/*!< Integrators (input rate, wrap around) */
+	uint32_t comb[ADC_DECIM_ORDER_MAX];			/*!< Comb delays (output rate) */
+	uint8_t phase;								/*!< Input samples since last output */
+} adc_decimator_t;
 /*==================[internal data declaration]==============================*/
-adc_cali_handle_t adc_calibration_single_0, adc_calibration_single_1, adc_calibration_single_2, adc_calibration_single_3;
+adc_cali_handle_t adc_calibration[ADC_INPUTS];	/*!< Calibration curve of each input */
+uint16_t *adc_cali_table[ADC_INPUTS];			/*!< Calibration table of each input: mV of each raw code (last one repeated) */
+uint8_t adc_cali_frac[ADC_INPUTS];				/*!< Fractional bits of the values converted with each table */
 adc_oneshot_unit_handle_t adc1_single; 
-adc_continuous_handle_t adc2_cont;
+adc_continuous_handle_t adc1_cont = NULL;
 sdm_channel_handle_t dac = NULL;
 bool adc1_single_used = false;
+adc_mode_t adc_cont_mode;				/*!< Mode of adc1_cont (continuous or scan) */
+void (*adc_cont_isr_p)(void*);			/*!< Pointer to the frame end function (continuous and scan modes) */
+void *adc_cont_user_data;				/*!< User data for frame end function */
+uint16_t adc_frame_lenght;				/*!< Samples (scans) per frame */
+uint16_t *adc_frame[2];					/*!< Ping-pong frame buffers (continuous mode) */
+volatile uint8_t adc_frame_write;		/*!< Buffer filled by next frame */
+volatile bool adc_frame_ready;			/*!< Buffer adc_frame_write ^ 1 has a complete frame */
+uint8_t adc_scan_lenght;				/*!< Channels per scan */
+int8_t adc_scan_slot[ADC_INPUTS];		/*!< Position of each input in the scan (-1: not scanned) */
+uint16_t *adc_scan_data[ADC_INPUTS];	/*!< Ring buffer of each scanned channel */
+int64_t *adc_scan_time;					/*!< Ring buffer of scan timestamps (us) */
+uint32_t adc_scan_mask;					/*!< Ring buffers lenght - 1 */
+int64_t adc_scan_period;				/*!< Scan period (ns) */
+volatile uint32_t adc_scan_write;		/*!< Scans written (ring buffers position: & adc_scan_mask) */
+uint32_t adc_scan_read;					/*!< Scans read */
+uint32_t adc_scan_overruns;				/*!< Scans lost because the buffers were full */
+uint8_t adc_os_bits;					/*!< log2 of oversampling factor (0: no oversampling) */
+uint8_t adc_decim_order;				/*!< Order of decimation filters */
+adc_decimator_t adc_decimator[ADC_INPUTS];	/*!< Decimation filter of each channel of the scan */
 /*==================[internal functions declaration]=========================*/
+/**
+ * @brief Decimation by CIC filter: accumulates one sample, returns true when an output sample
+ * (mean of the input, with ADC_OVERSAMPLING_FRAC fractional bits) is ready
+ */
+static inline bool IRAM_ATTR AnalogDecimate(adc_decimator_t *decim, uint32_t *value){
+	uint32_t acc = *value;
+	for(uint8_t k=0; k<adc_decim_order; k++){
+		decim->integrator[k] += acc;
+		acc = decim->integrator[k];
+	}
+	if(++decim->phase < (1 << adc_os_bits)){
+		return false;
+	}
+	decim->phase = 0;
+	for(uint8_t k=0; k<adc_decim_order; k++){
+		uint32_t delayed = decim->comb[k];
+		decim->comb[k] = acc;
+		acc -= delayed;
+	}
+	// Gain of the filter is oversampling ^ order (at most 2^12: no overflow of 12 + 4 + 12 bits)
+	uint8_t shift = adc_os_bits * adc_decim_order;
+	*value = ((acc << ADC_OVERSAMPLING_FRAC) + ((1 << shift) >> 1)) >> shift;
+	return true;
+}
+
+/**
+ * @brief Conversion frame end (DMA), decimates the samples when oversampling and unpacks the
+ * frame into the next ping-pong buffer (continuous mode) or into the ring buffer of each
+ * channel (scan mode)
+ */
+static bool IRAM_ATTR adc_cont_isr(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data){
+	uint32_t n = edata->size / SOC_ADC_DIGI_RESULT_BYTES;
+	int64_t now = esp_timer_get_time();
+	uint16_t *frame = adc_frame[adc_frame_write];
+	uint16_t frame_pos = 0;
+	uint32_t write = adc_scan_write;
+	uint32_t first = write;
+	for(uint32_t i=0; i<n; i++){
+		adc_digi_output_data_t *p = (adc_digi_output_data_t*)&edata->conv_frame_buffer[i * SOC_ADC_DIGI_RESULT_BYTES];
+		uint32_t ch = ADC_GET_CHANNEL(p);
+		if((ch >= ADC_INPUTS) || (adc_scan_slot[ch] < 0)){
+			continue;
+		}
+		uint8_t slot = adc_scan_slot[ch];
+		uint32_t value = ADC_GET_DATA(p);
+		if((adc_os_bits > 0) && !AnalogDecimate(&adc_decimator[slot], &value)){
+			continue;
+		}
+		if(adc_cont_mode == ADC_CONTINUOUS){
+			if(frame_pos < adc_frame_lenght){
+				frame[frame_pos++] = value;
+			}
+		}
+		else{
+			adc_scan_data[slot][write & adc_scan_mask] = value;
+			// Scan complete with its last channel
+			if(slot == adc_scan_lenght - 1){
+				write++;
+			}
+		}
+	}
+	if(adc_cont_mode == ADC_CONTINUOUS){
+		adc_frame_write ^= 1;
+		adc_frame_ready = true;
+	}
+	else{
+		// Last scan of the frame converted now, the others one scan period before each
+		for(uint32_t k=first; k!=write; k++){
+			adc_scan_time[k & adc_scan_mask] = now - ((write - 1 - k) * adc_scan_period) / 1000;
+		}
+		// Data is stored before the task can see the new scans
+		__atomic_store_n(&adc_scan_write, write, __ATOMIC_RELEASE);
+	}
+	if(adc_cont_isr_p != NULL){
+		adc_cont_isr_p(adc_cont_user_data);
+	}
+	return true;
+}
+
+/**
+ * @brief Build the calibration table of an input (mV of each raw code) from its calibration
+ * curve, or load it from NVS
+ */
+static void AnalogCalibrationInit(adc_ch_t input, bool nvs_store){
+	nvs_handle_t nvs;
+	char key[NVS_KEY_NAME_MAX_SIZE];
+	size_t size = ADC_CALI_LENGHT * sizeof(uint16_t);
+	if(adc_cali_table[input] != NULL){
+		return;
+	}
+	uint16_t *table = malloc(size + sizeof(uint16_t));
+	if(table == NULL){
+		ESP_LOGE(TAG, "Not enough memory for calibration table");
+		return;
+	}
+	if(nvs_store){
+		// The partition is never erased here (it holds other data): the table is built in RAM
+		esp_err_t ret = nvs_flash_init();
+		if(ret != ESP_OK){
+			ESP_LOGE(TAG, "NVS not available (%s), calibration table of CH%d not stored", esp_err_to_name(ret), input);
+		}
+		nvs_store = (ret == ESP_OK) && (nvs_open(ADC_CALI_NAMESPACE, NVS_READWRITE, &nvs) == ESP_OK);
+		// Table depends on input, attenuation and bit width (blob size)
+		snprintf(key, sizeof(key), "cali%d_%d", input, ADC_ATTENUATION);
+	}
+	if(!nvs_store || (nvs_get_blob(nvs, key, table, &size) != ESP_OK) || (size != ADC_CALI_LENGHT * sizeof(uint16_t))){
+		if(adc_calibration[input] == NULL){
+			adc_cali_curve_fitting_config_t cali_config = {
+				.unit_id = ADC_UNIT_1,
+				.chan = (adc_channel_t)input,
+				.atten = ADC_ATTENUATION,
+				.bitwidth = ADC_BITWIDTH,
+			};
+			ESP_ERROR_CHECK(adc_cali_create_scheme_curve_fitting(&cali_config, &adc_calibration[input]));
+		}
+		for(int raw=0; raw<ADC_CALI_LENGHT; raw++){
+			int mv = 0;
+			adc_cali_raw_to_voltage(adc_calibration[input], raw, &mv);
+			table[raw] = mv;
+		}
+		if(nvs_store && ((nvs_set_blob(nvs, key, table, ADC_CALI_LENGHT * sizeof(uint16_t)) != ESP_OK) || (nvs_commit(nvs) != ESP_OK))){
+			ESP_LOGE(TAG, "Calibration table of CH%d not stored", input);
+		}
+	}
+	if(nvs_store){
+		nvs_close(nvs);
+	}
+	// Interpolation of the last code (oversampling) reads one more entry
+	table[ADC_CALI_LENGHT] = table[ADC_CALI_LENGHT - 1];
+	adc_cali_table[input] = table;
+}
+
+/**
+ * @brief Continuous and scan modes initialization (ADC 1 sampled by DMA)
+ */
+static void AnalogContinuousInit(analog_input_config_t *config){
+	adc_digi_pattern_config_t pattern[ADC_INPUTS];
+	const adc_ch_t *channels = &config->input;
+	uint8_t n_channels = 1;
+	if(config->mode == ADC_SCAN){
+		channels = config->scan_list;
+		n_channels = config->scan_lenght;
+		if((channels == NULL) || (n_channels == 0) || (n_channels > ADC_INPUTS)){
+			ESP_LOGE(TAG, "Invalid scan list");
+			return;
+		}
+		// Each input has one slot in the scan (indexes adc_scan_slot[])
+		uint8_t used = 0;
+		for(uint8_t i=0; i<n_channels; i++){
+			if(((uint32_t)channels[i] >= ADC_INPUTS) || (used & (1 << channels[i]))){
+				ESP_LOGE(TAG, "Invalid scan list: CH%d out of range or repeated", channels[i]);
+				return;
+			}
+			used |= 1 << channels[i];
+		}
+	}
+	uint8_t os = (config->oversampling > 0) ? config->oversampling : 1;
+	if(((os & (os - 1)) != 0) || (os > ADC_OVERSAMPLING_MAX)){
+		ESP_LOGE(TAG, "Invalid oversampling: %d", config->oversampling);
+		return;
+	}
+	if((config->decimation != ADC_DECIMATION_BOXCAR) && (config->decimation != ADC_DECIMATION_CIC)){
+		ESP_LOGE(TAG, "Invalid decimation filter: %d", config->decimation);
+		return;
+	}
+	uint32_t conv_frec = config->sample_frec * n_channels * os;
+	if((conv_frec < SOC_ADC_SAMPLE_FREQ_THRES_LOW) || (conv_frec > SOC_ADC_SAMPLE_FREQ_THRES_HIGH)){
+		ESP_LOGE(TAG, "Invalid conversion frequency: %lu Hz (sample_frec x channels x oversampling)", (unsigned long)conv_frec);
+		return;
+	}
+	uint16_t frame_lenght = (config->frame_lenght > 0) ? config->frame_lenght : ADC_FRAME_LENGHT / os;
+	uint32_t lenght = (config->buffer_lenght > 0) ? config->buffer_lenght : ADC_BUFFER_LENGHT;
+	if((config->mode == ADC_SCAN) && (((lenght & (lenght - 1)) != 0) || (lenght < frame_lenght))){
+		ESP_LOGE(TAG, "Invalid buffer lenght: %lu (power of two, at least frame_lenght)", (unsigned long)lenght);
+		return;
+	}
+	// Re-initialization: release the previous handle (stopped, so the ISR no longer uses
+	// the buffers) and buffers before changing the configuration
+	if(adc1_cont != NULL){
+		adc_continuous_stop(adc1_cont);		// fails (ignored) if not started
+		ESP_ERROR_CHECK(adc_continuous_deinit(adc1_cont));
+		adc1_cont = NULL;
+	}
+	free(adc_frame[0]);
+	free(adc_scan_data[0]);
+	free(adc_scan_time);
+	adc_frame[0] = NULL;
+	adc_scan_data[0] = NULL;
+	adc_scan_time = NULL;
+	adc_os_bits = 0;
+	while((1 << adc_os_bits) < os){
+		adc_os_bits++;
+	}
+	adc_decim_order = (config->decimation == ADC_DECIMATION_CIC) ? ADC_DECIM_ORDER_MAX : 1;
+	memset(adc_decimator, 0, sizeof(adc_decimator));
+	adc_frame_lenght = frame_lenght;
+	if(config->mode == ADC_SCAN){
+		adc_scan_data[0] = malloc(n_channels * lenght * sizeof(uint16_t));
+		adc_scan_time = malloc(lenght * sizeof(int64_t));
+		if((adc_scan_data[0] == NULL) || (adc_scan_time == NULL)){
+			ESP_LOGE(TAG, "Not enough memory for ADC scan buffers");
+			free(adc_scan_data[0]);
+			free(adc_scan_time);
+			adc_scan_data[0] = NULL;
+			adc_scan_time = NULL;
+			return;
+		}
+		for(uint8_t i=0; i<n_channels; i++){
+			adc_scan_data[i] = &adc_scan_data[0][i * lenght];
+		}
+		adc_scan_mask = lenght - 1;
+		adc_scan_period = 1000000000LL / config->sample_frec;
+		adc_scan_write = 0;
+		adc_scan_read = 0;
+		adc_scan_overruns = 0;
+	}
+	else{
+		adc_frame[0] = malloc(2 * adc_frame_lenght * sizeof(uint16_t));
+		if(adc_frame[0] == NULL){
+			ESP_LOGE(TAG, "Not enough memory for ADC frames");
+			return;
+		}
+		adc_frame[1] = &adc_frame[0][adc_frame_lenght];
+		adc_frame_write = 0;
+		adc_frame_ready = false;
+	}
+	// Continuous mode is a scan of one channel
+	memset(adc_scan_slot, -1, sizeof(adc_scan_slot));
+	for(uint8_t i=0; i<n_channels; i++){
+		adc_scan_slot[channels[i]] = i;
+		AnalogCalibrationInit(channels[i], config->cali_nvs);
+		// Oversampled values have fractional bits
+		adc_cali_frac[channels[i]] = (adc_os_bits > 0) ? ADC_OVERSAMPLING_FRAC : 0;
+	}
+	adc_scan_lenght = n_channels;
+	adc_cont_mode = config->mode;
+	adc_cont_isr_p = config->func_p;
+	adc_cont_user_data = config->param_p;
+	// One DMA frame per ping-pong frame (frame_lenght scans in scan mode, before decimation)
+	uint32_t frame_size = adc_frame_lenght * n_channels * os * SOC_ADC_DIGI_RESULT_BYTES;
+	adc_continuous_handle_cfg_t handle_config = {
+		.max_store_buf_size = 2 * frame_size,
+		.conv_frame_size = frame_size,
+	};
+	ESP_ERROR_CHECK(adc_continuous_new_handle(&handle_config, &adc1_cont));
+	// Channels of a scan are converted one after the other by the ADC
+	for(uint8_t i=0; i<n_channels; i++){
+		pattern[i].atten = ADC_ATTENUATION;
+		pattern[i].channel = (adc_channel_t)channels[i];
+		pattern[i].unit = ADC_UNIT_1;
+		pattern[i].bit_width = ADC_BITWIDTH;
+	}
+	adc_continuous_config_t cont_config = {
+		.pattern_num = n_channels,
+		.adc_pattern = pattern,
+		.sample_freq_hz = conv_frec,
+		.conv_mode = ADC_CONV_SINGLE_UNIT_1,
+		.format = ADC_OUTPUT_TYPE,
+	};
+	ESP_ERROR_CHECK(adc_continuous_config(adc1_cont, &cont_config));
+	adc_continuous_evt_cbs_t callbacks = {
+		.on_conv_done = adc_cont_isr,
+	};
+	ESP_ERROR_CHECK(adc_continuous_register_event_callbacks(adc1_cont, &callbacks, NULL));
+}
 
 /*==================[internal data definition]===============================*/
 adc_oneshot_unit_init_cfg_t init_config_single = {
@@ -51,68 +368,14 @@ void AnalogInputInit(analog_input_config_t *config){
 				adc_oneshot_new_unit(&init_config_single, &adc1_single);
 				adc1_single_used = true;
 			}
-			switch(config->input){
-				case CH0:
-    				adc_oneshot_config_channel(adc1_single, ADC_CHANNEL_0, &adc_config_single);
-					// create calibration curve
-					adc_cali_curve_fitting_config_t cali_config_0 = {
-						.unit_id = ADC_UNIT_1,
-						.chan = ADC_CHANNEL_0, 
-						.atten = ADC_ATTENUATION,
-						.bitwidth = ADC_BITWIDTH,
-					};
-					ESP_ERROR_CHECK(adc_cali_create_scheme_curve_fitting(&cali_config_0, &adc_calibration_single_0));
-				break;
-				case CH1:
-    				adc_oneshot_config_channel(adc1_single, ADC_CHANNEL_1, &adc_config_single);
-					// create calibration curve
-					adc_cali_curve_fitting_config_t cali_config_1 = {
-						.unit_id = ADC_UNIT_1,
-						.chan = ADC_CHANNEL_1, 
-						.atten = ADC_ATTENUATION,
-						.bitwidth = ADC_BITWIDTH,
-					};
-					ESP_ERROR_CHECK(adc_cali_create_scheme_curve_fitting(&cali_config_1, &adc_calibration_single_1));
-				break;
-				case CH2:
-    				adc_oneshot_config_channel(adc1_single, ADC_CHANNEL_2, &adc_config_single);
-					// create calibration curve
-					adc_cali_curve_fitting_config_t cali_config_2 = {
-						.unit_id = ADC_UNIT_1,
-						.chan = ADC_CHANNEL_2, 
-						.atten = ADC_ATTENUATION,
-						.bitwidth = ADC_BITWIDTH,
-					};
-					ESP_ERROR_CHECK(adc_cali_create_scheme_curve_fitting(&cali_config_2, &adc_calibration_single_2));
-				break;
-				case CH3:
-    				adc_oneshot_config_channel(adc1_single, ADC_CHANNEL_3, &adc_config_single);
-					// create calibration curve
-					adc_cali_curve_fitting_config_t cali_config_3 = {
-						.unit_id = ADC_UNIT_1,
-						.chan = ADC_CHANNEL_3, 
-						.atten = ADC_ATTENUATION,
-						.bitwidth = ADC_BITWIDTH,
-					};
-					ESP_ERROR_CHECK(adc_cali_create_scheme_curve_fitting(&cali_config_3, &adc_calibration_single_3));
-				break;
-			}
+			// Inputs CH0 to CH3 are ADC 1 channels 0 to 3
+			adc_oneshot_config_channel(adc1_single, (adc_channel_t)config->input, &adc_config_single);
+			// create calibration table
+			AnalogCalibrationInit(config->input, config->cali_nvs);
 		break;
 		case ADC_CONTINUOUS:
-			switch(config->input){
-				case CH0:
-
-				break;
-				case CH1:
-
-				break;
-				case CH2:
-
-				break;
-				case CH3:
-
-				break;
-			}
+		case ADC_SCAN:
+			AnalogContinuousInit(config);
 		break;
 	}
 }
@@ -128,32 +391,124 @@ void AnalogOutputInit(void){
 }
 
 void AnalogInputReadSingle(adc_ch_t channel, uint16_t *value){
-    switch(channel){
-		case CH0:
-			adc_oneshot_read(adc1_single, ADC_CHANNEL_0, (int*)value);
-		break;
-		case CH1:
-			adc_oneshot_read(adc1_single, ADC_CHANNEL_1, (int*)value);
-		break;
-		case CH2:
-			adc_oneshot_read(adc1_single, ADC_CHANNEL_2, (int*)value);
-		break;
-		case CH3:
-			adc_oneshot_read(adc1_single, ADC_CHANNEL_3, (int*)value);
-		break;
-	}
+	int raw = 0;
+	adc_oneshot_read(adc1_single, (adc_channel_t)channel, &raw);
+	*value = (adc_cali_table[channel] != NULL) ? adc_cali_table[channel][raw & (ADC_CALI_LENGHT - 1)] : raw;
 }
 
 void AnalogStartContinuous(adc_ch_t channel){
-
+	if(adc1_cont != NULL){
+		adc_frame_write = 0;
+		adc_frame_ready = false;
+		adc_continuous_start(adc1_cont);
+	}
 }
 
 void AnalogStopContinuous(adc_ch_t channel){
+	if(adc1_cont != NULL){
+		adc_continuous_stop(adc1_cont);		// fails (ignored) if not started
+	}
+}
 
+uint16_t AnalogInputReadContinuous(adc_ch_t channel, uint16_t *values){
+	if(!adc_frame_ready){
+		return 0;
+	}
+	// Last complete frame: the one not being filled
+	memcpy(values, adc_frame[adc_frame_write ^ 1], adc_frame_lenght * sizeof(uint16_t));
+	return adc_frame_lenght;
 }
 
-void AnalogInputReadContinuous(adc_ch_t channel, uint16_t *values){
+uint16_t AnalogInputReadScan(uint16_t **values, int64_t *timestamps, uint16_t lenght){
+	uint32_t write = __atomic_load_n(&adc_scan_write, __ATOMIC_ACQUIRE);
+	uint32_t available = write - adc_scan_read;
+	// Oldest scans overwritten: skip them
+	if(available > adc_scan_mask + 1){
+		adc_scan_overruns += available - (adc_scan_mask + 1);
+		adc_scan_read = write - (adc_scan_mask + 1);
+		available = adc_scan_mask + 1;
+	}
+	if(lenght > available){
+		lenght = available;
+	}
+	for(uint16_t i=0; i<lenght; i++){
+		uint32_t pos = (adc_scan_read + i) & adc_scan_mask;
+		for(uint8_t ch=0; ch<adc_scan_lenght; ch++){
+			values[ch][i] = adc_scan_data[ch][pos];
+		}
+		if(timestamps != NULL){
+			timestamps[i] = adc_scan_time[pos];
+		}
+	}
+	// The ISR doesn't wait for the reader: scans overwritten while they were being copied
+	// (mixed channels or timestamp) are dropped and counted as overruns
+	uint32_t first = adc_scan_read;
+	uint32_t oldest = __atomic_load_n(&adc_scan_write, __ATOMIC_ACQUIRE) - (adc_scan_mask + 1);
+	adc_scan_read += lenght;
+	if((int32_t)(oldest - first) > 0){
+		uint32_t lost = oldest - first;
+		adc_scan_overruns += lost;
+		if(lost >= lenght){
+			adc_scan_read = oldest;
+			return 0;
+		}
+		lenght -= lost;
+		for(uint8_t ch=0; ch<adc_scan_lenght; ch++){
+			memmove(values[ch], &values[ch][lost], lenght * sizeof(uint16_t));
+		}
+		if(timestamps != NULL){
+			memmove(timestamps, &timestamps[lost], lenght * sizeof(int64_t));
+		}
+	}
+	return lenght;
+}
 
+uint32_t AnalogInputScanOverruns(void){
+	return adc_scan_overruns;
+}
+
+bool AnalogInputConvert(adc_ch_t channel, const uint16_t *raw, uint16_t *mv, uint16_t lenght){
+	const uint16_t *table = adc_cali_table[channel];
+	uint8_t frac = adc_cali_frac[channel];
+	if(table == NULL){
+		return false;
+	}
+	if(frac == 0){
+		for(uint16_t i=0; i<lenght; i++){
+			mv[i] = table[raw[i] & (ADC_CALI_LENGHT - 1)];
+		}
+	}
+	else{
+		// Oversampled values: linear interpolation between codes
+		for(uint16_t i=0; i<lenght; i++){
+			const uint16_t *t = &table[(raw[i] >> frac) & (ADC_CALI_LENGHT - 1)];
+			uint32_t x = raw[i] & ((1 << frac) - 1);
+			mv[i] = t[0] + (((t[1] - t[0]) * x + (1 << (frac - 1))) >> frac);
+		}
+	}
+	return true;
+}
+
+bool AnalogInputConvertFloat(adc_ch_t channel, const uint16_t *raw, float *mv, uint16_t lenght){
+	const uint16_t *table = adc_cali_table[channel];
+	uint8_t frac = adc_cali_frac[channel];
+	if(table == NULL){
+		return false;
+	}
+	if(frac == 0){
+		for(uint16_t i=0; i<lenght; i++){
+			mv[i] = table[raw[i] & (ADC_CALI_LENGHT - 1)];
+		}
+	}
+	else{
+		// Oversampled values: linear interpolation between codes
+		float step = 1.0f / (1 << frac);
+		for(uint16_t i=0; i<lenght; i++){
+			const uint16_t *t = &table[(raw[i] >> frac) & (ADC_CALI_LENGHT - 1)];
+			mv[i] = t[0] + (t[1] - t[0]) * (raw[i] & ((1 << frac) - 1)) * step;
+		}
+	}
+	return true;
 }
 
 void AnalogOutputWrite(uint8_t value){
@@ -0,0 +1,31 @@
+/**
+ * @file ring_buffer_mcu.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "ring_buffer_mcu.h"
+/*==================[macros and definitions]=================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+RING_BUFFER_DEFINE(i16, I16, int16_t)
+RING_BUFFER_DEFINE(u16, U16, uint16_t)
+RING_BUFFER_DEFINE(f32, F32, float)
+
+/*==================[end of file]============================================*/
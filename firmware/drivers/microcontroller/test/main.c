@@ -0,0 +1,27 @@
+/**
+ * @file main.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host tests of the microcontroller drivers (see Makefile)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+/*==================[external functions declaration]=========================*/
+int test_ring_buffer_mcu(void);
+int test_analog_io_mcu(void);
+/*==================[external functions definition]==========================*/
+int main(void){
+	int errors = 0;
+	printf("main starts!\n");
+	errors += test_ring_buffer_mcu();
+	errors += test_analog_io_mcu();
+	printf("Test done: %s (%d errors)\n", (errors == 0) ? "PASS" : "FAIL", errors);
+	return (errors == 0) ? 0 : 1;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,3 @@
+/* Host mock of ESP-IDF driver/gptimer.h (included, not used, by analog_io_mcu.c) */
+#pragma once
+#include "esp_err.h"
@@ -0,0 +1,17 @@
+/* Host mock of ESP-IDF driver/sdm.h (DAC output, not exercised by the tests) */
+#pragma once
+#include <stdint.h>
+#include "esp_err.h"
+
+typedef struct sdm_channel_t *sdm_channel_handle_t;
+typedef struct {
+	int clk_src;
+	uint32_t sample_rate_hz;
+	int gpio_num;
+} sdm_config_t;
+
+#define SDM_CLK_SRC_DEFAULT	0
+
+static inline esp_err_t sdm_new_channel(const sdm_config_t *config, sdm_channel_handle_t *ret_chan){ *ret_chan = NULL; return ESP_OK; }
+static inline esp_err_t sdm_channel_enable(sdm_channel_handle_t chan){ return ESP_OK; }
+static inline esp_err_t sdm_channel_set_pulse_density(sdm_channel_handle_t chan, int8_t density){ return ESP_OK; }
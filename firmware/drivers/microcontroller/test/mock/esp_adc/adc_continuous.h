@@ -0,0 +1,35 @@
+/* Host mock of ESP-IDF esp_adc/adc_continuous.h (frames generated by mock_adc_run_frames()) */
+#pragma once
+#include "esp_adc/adc_types.h"
+
+typedef struct adc_continuous_ctx_t *adc_continuous_handle_t;
+typedef struct {
+	uint32_t max_store_buf_size;
+	uint32_t conv_frame_size;
+	struct {
+		uint32_t flush_pool: 1;
+	} flags;
+} adc_continuous_handle_cfg_t;
+typedef struct {
+	uint32_t pattern_num;
+	adc_digi_pattern_config_t *adc_pattern;
+	uint32_t sample_freq_hz;
+	adc_digi_convert_mode_t conv_mode;
+	adc_digi_output_format_t format;
+} adc_continuous_config_t;
+typedef struct {
+	uint8_t *conv_frame_buffer;
+	uint32_t size;
+} adc_continuous_evt_data_t;
+typedef bool (*adc_continuous_callback_t)(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data);
+typedef struct {
+	adc_continuous_callback_t on_conv_done;
+	adc_continuous_callback_t on_pool_ovf;
+} adc_continuous_evt_cbs_t;
+
+esp_err_t adc_continuous_new_handle(const adc_continuous_handle_cfg_t *hdl_config, adc_continuous_handle_t *ret_handle);
+esp_err_t adc_continuous_config(adc_continuous_handle_t handle, const adc_continuous_config_t *config);
+esp_err_t adc_continuous_register_event_callbacks(adc_continuous_handle_t handle, const adc_continuous_evt_cbs_t *cbs, void *user_data);
+esp_err_t adc_continuous_start(adc_continuous_handle_t handle);
+esp_err_t adc_continuous_stop(adc_continuous_handle_t handle);
+esp_err_t adc_continuous_deinit(adc_continuous_handle_t handle);
@@ -0,0 +1,5 @@
+/* Host mock of ESP-IDF esp_attr.h: no IRAM / DRAM sections on the host */
+#pragma once
+
+#define IRAM_ATTR
+#define DRAM_ATTR
@@ -0,0 +1,21 @@
+/* Host mock of ESP-IDF esp_err.h (only what the drivers under test use) */
+#pragma once
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef int esp_err_t;
+
+#define ESP_OK					0
+#define ESP_FAIL				-1
+#define ESP_ERR_NO_MEM			0x101
+#define ESP_ERR_INVALID_ARG		0x102
+#define ESP_ERR_INVALID_STATE	0x103
+#define ESP_ERR_NOT_FOUND		0x105
+
+/* Like the IDF one: abort on error */
+#define ESP_ERROR_CHECK(x)	do{ esp_err_t err_ = (x); if(err_ != ESP_OK){ \
+	fprintf(stderr, "ESP_ERROR_CHECK failed: 0x%x at %s:%d\n", err_, __FILE__, __LINE__); abort(); } }while(0)
+
+static inline const char *esp_err_to_name(esp_err_t err){
+	return (err == ESP_OK) ? "ESP_OK" : "ESP_ERR";
+}
@@ -0,0 +1,8 @@
+/* Host mock of ESP-IDF esp_log.h: errors to stderr, other levels discarded */
+#pragma once
+#include <stdio.h>
+
+#define ESP_LOGE(tag, fmt, ...)	fprintf(stderr, "E %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...)
+#define ESP_LOGI(tag, fmt, ...)
+#define ESP_LOGD(tag, fmt, ...)
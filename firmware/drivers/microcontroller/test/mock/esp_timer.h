@@ -0,0 +1,9 @@
+/* Host mock of ESP-IDF esp_timer.h: time set by the test (mock_time_us) */
+#pragma once
+#include <stdint.h>
+
+extern int64_t mock_time_us;
+
+static inline int64_t esp_timer_get_time(void){
+	return mock_time_us;
+}
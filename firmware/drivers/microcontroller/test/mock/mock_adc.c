@@ -0,0 +1,140 @@
+/* Host mock of the ESP-IDF oneshot, continuous and calibration ADC drivers.
+ * Continuous mode converts the pattern in order, conversion k of channel ch reads
+ * mock_value(k, ch), and calls on_conv_done after each frame like the DMA ISR. */
+#include <string.h>
+#include "esp_adc/adc_oneshot.h"
+#include "esp_adc/adc_cali_scheme.h"
+#include "esp_adc/adc_continuous.h"
+#include "mock_idf.h"
+
+struct adc_continuous_ctx_t {
+	adc_continuous_handle_cfg_t handle_cfg;
+	adc_continuous_config_t config;
+	adc_digi_pattern_config_t pattern[SOC_ADC_PATT_LEN_MAX];
+	adc_continuous_evt_cbs_t cbs;
+	void *user_data;
+	bool created;				/* Between new_handle() and deinit() (IDF: ADC DMA in use) */
+	bool started;
+	uint32_t conversions;
+	uint8_t frame[8192];
+};
+struct adc_cali_scheme_t {
+	int chan;
+};
+
+static struct adc_continuous_ctx_t adc_ctx;
+static struct adc_cali_scheme_t cali_ctx[8];
+
+int64_t mock_time_us;
+int mock_oneshot_value[8];
+int mock_cali_calls;
+int mock_deinit_calls;
+
+uint16_t mock_value(uint32_t k, int ch){
+	return (k * 7 + ch * 1000) & 0xFFF;
+}
+
+esp_err_t adc_oneshot_new_unit(const adc_oneshot_unit_init_cfg_t *init_config, adc_oneshot_unit_handle_t *ret_unit){
+	*ret_unit = (adc_oneshot_unit_handle_t)&adc_ctx;
+	return ESP_OK;
+}
+
+esp_err_t adc_oneshot_config_channel(adc_oneshot_unit_handle_t handle, adc_channel_t channel, const adc_oneshot_chan_cfg_t *config){
+	return ESP_OK;
+}
+
+esp_err_t adc_oneshot_read(adc_oneshot_unit_handle_t handle, adc_channel_t chan, int *out_raw){
+	*out_raw = mock_oneshot_value[chan];
+	return ESP_OK;
+}
+
+/* Monotonic curve, slightly non linear, with an offset per channel */
+esp_err_t adc_cali_create_scheme_curve_fitting(const adc_cali_curve_fitting_config_t *config, adc_cali_handle_t *ret_handle){
+	cali_ctx[config->chan].chan = config->chan;
+	*ret_handle = &cali_ctx[config->chan];
+	return ESP_OK;
+}
+
+esp_err_t adc_cali_raw_to_voltage(adc_cali_handle_t handle, int raw, int *voltage){
+	mock_cali_calls++;
+	*voltage = (int)(raw * 3100.0 / 4095 + 0.00002 * raw * (4095 - raw)) + 10 * handle->chan;
+	return ESP_OK;
+}
+
+esp_err_t adc_continuous_new_handle(const adc_continuous_handle_cfg_t *hdl_config, adc_continuous_handle_t *ret_handle){
+	if(adc_ctx.created){
+		return ESP_ERR_NOT_FOUND;
+	}
+	if(((hdl_config->conv_frame_size % SOC_ADC_DIGI_DATA_BYTES_PER_CONV) != 0) || (hdl_config->conv_frame_size > sizeof(adc_ctx.frame))){
+		return ESP_ERR_INVALID_ARG;
+	}
+	memset(&adc_ctx, 0, sizeof(adc_ctx));
+	adc_ctx.handle_cfg = *hdl_config;
+	adc_ctx.created = true;
+	*ret_handle = &adc_ctx;
+	return ESP_OK;
+}
+
+esp_err_t adc_continuous_config(adc_continuous_handle_t handle, const adc_continuous_config_t *config){
+	if((config->pattern_num == 0) || (config->pattern_num > SOC_ADC_PATT_LEN_MAX)){
+		return ESP_ERR_INVALID_ARG;
+	}
+	if((config->sample_freq_hz < SOC_ADC_SAMPLE_FREQ_THRES_LOW) || (config->sample_freq_hz > SOC_ADC_SAMPLE_FREQ_THRES_HIGH)){
+		return ESP_ERR_INVALID_ARG;
+	}
+	handle->config = *config;
+	memcpy(handle->pattern, config->adc_pattern, config->pattern_num * sizeof(adc_digi_pattern_config_t));
+	return ESP_OK;
+}
+
+esp_err_t adc_continuous_register_event_callbacks(adc_continuous_handle_t handle, const adc_continuous_evt_cbs_t *cbs, void *user_data){
+	handle->cbs = *cbs;
+	handle->user_data = user_data;
+	return ESP_OK;
+}
+
+esp_err_t adc_continuous_start(adc_continuous_handle_t handle){
+	if(handle->started){
+		return ESP_ERR_INVALID_STATE;
+	}
+	handle->started = true;
+	return ESP_OK;
+}
+
+esp_err_t adc_continuous_stop(adc_continuous_handle_t handle){
+	if(!handle->started){
+		return ESP_ERR_INVALID_STATE;
+	}
+	handle->started = false;
+	return ESP_OK;
+}
+
+esp_err_t adc_continuous_deinit(adc_continuous_handle_t handle){
+	if(handle->started){
+		return ESP_ERR_INVALID_STATE;
+	}
+	handle->created = false;
+	mock_deinit_calls++;
+	return ESP_OK;
+}
+
+void mock_adc_run_frames(int n_frames){
+	uint32_t n = adc_ctx.handle_cfg.conv_frame_size / SOC_ADC_DIGI_RESULT_BYTES;
+	for(int f=0; (f<n_frames) && adc_ctx.started; f++){
+		for(uint32_t i=0; i<n; i++){
+			adc_digi_pattern_config_t *p = &adc_ctx.pattern[adc_ctx.conversions % adc_ctx.config.pattern_num];
+			adc_digi_output_data_t d = {0};
+			d.type2.data = mock_value(adc_ctx.conversions, p->channel);
+			d.type2.channel = p->channel;
+			memcpy(&adc_ctx.frame[i * SOC_ADC_DIGI_RESULT_BYTES], &d, SOC_ADC_DIGI_RESULT_BYTES);
+			adc_ctx.conversions++;
+		}
+		adc_continuous_evt_data_t edata = {
+			.conv_frame_buffer = adc_ctx.frame,
+			.size = adc_ctx.handle_cfg.conv_frame_size,
+		};
+		if(adc_ctx.cbs.on_conv_done != NULL){
+			adc_ctx.cbs.on_conv_done(&adc_ctx, &edata, adc_ctx.user_data);
+		}
+	}
+}
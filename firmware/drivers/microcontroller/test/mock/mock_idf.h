@@ -0,0 +1,19 @@
+/* Control and inspection of the host mocks of the ESP-IDF ADC, calibration and NVS APIs */
+#pragma once
+#include <stdint.h>
+#include "esp_err.h"
+
+extern int64_t mock_time_us;			/* esp_timer_get_time() value */
+extern int mock_oneshot_value[8];		/* adc_oneshot_read() raw value of each channel */
+extern int mock_cali_calls;				/* adc_cali_raw_to_voltage() calls */
+extern int mock_deinit_calls;			/* adc_continuous_deinit() calls */
+extern int mock_nvs_sets;				/* nvs_set_blob() calls */
+extern int mock_nvs_erases;				/* nvs_flash_erase() calls */
+extern esp_err_t mock_nvs_init_ret;		/* nvs_flash_init() result */
+
+/* Raw value of conversion k (counted since the handle was created) of channel ch */
+uint16_t mock_value(uint32_t k, int ch);
+/* Convert n_frames DMA frames (pattern in order) and call on_conv_done after each one (if started) */
+void mock_adc_run_frames(int n_frames);
+/* Empty the NVS storage */
+void mock_nvs_clear(void);
@@ -0,0 +1,76 @@
+/* Host mock of ESP-IDF NVS: blobs kept in RAM (survive a simulated reboot, not a new process) */
+#include <string.h>
+#include "nvs_flash.h"
+#include "nvs.h"
+#include "mock_idf.h"
+
+#define MOCK_NVS_ENTRIES	8
+
+static struct {
+	char key[NVS_KEY_NAME_MAX_SIZE];
+	uint8_t data[8192 + 16];
+	size_t size;
+} nvs_store[MOCK_NVS_ENTRIES];
+static int nvs_entries;
+
+int mock_nvs_sets;
+int mock_nvs_erases;
+esp_err_t mock_nvs_init_ret = ESP_OK;
+
+void mock_nvs_clear(void){
+	nvs_entries = 0;
+}
+
+esp_err_t nvs_flash_init(void){
+	return mock_nvs_init_ret;
+}
+
+esp_err_t nvs_flash_erase(void){
+	mock_nvs_erases++;
+	mock_nvs_clear();
+	return ESP_OK;
+}
+
+esp_err_t nvs_open(const char *name, nvs_open_mode_t open_mode, nvs_handle_t *out_handle){
+	*out_handle = 1;
+	return ESP_OK;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char *key, void *out_value, size_t *length){
+	for(int i=0; i<nvs_entries; i++){
+		if(strcmp(nvs_store[i].key, key) == 0){
+			if(*length < nvs_store[i].size){
+				return ESP_ERR_NVS_INVALID_LENGTH;
+			}
+			memcpy(out_value, nvs_store[i].data, nvs_store[i].size);
+			*length = nvs_store[i].size;
+			return ESP_OK;
+		}
+	}
+	return ESP_ERR_NVS_NOT_FOUND;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key, const void *value, size_t length){
+	int i = 0;
+	while((i < nvs_entries) && (strcmp(nvs_store[i].key, key) != 0)){
+		i++;
+	}
+	if((i == MOCK_NVS_ENTRIES) || (length > sizeof(nvs_store[i].data))){
+		return ESP_ERR_NO_MEM;
+	}
+	if(i == nvs_entries){
+		nvs_entries++;
+	}
+	strncpy(nvs_store[i].key, key, NVS_KEY_NAME_MAX_SIZE - 1);
+	memcpy(nvs_store[i].data, value, length);
+	nvs_store[i].size = length;
+	mock_nvs_sets++;
+	return ESP_OK;
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle){
+	return ESP_OK;
+}
+
+void nvs_close(nvs_handle_t handle){
+}
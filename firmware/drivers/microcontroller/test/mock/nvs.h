@@ -0,0 +1,23 @@
+/* Host mock of ESP-IDF nvs.h (blobs kept in RAM by mock_nvs.c) */
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#define NVS_KEY_NAME_MAX_SIZE			16
+#define ESP_ERR_NVS_NOT_FOUND			0x1102
+#define ESP_ERR_NVS_INVALID_LENGTH		0x110c
+#define ESP_ERR_NVS_NO_FREE_PAGES		0x110d
+#define ESP_ERR_NVS_NEW_VERSION_FOUND	0x1110
+
+typedef uint32_t nvs_handle_t;
+typedef enum {
+	NVS_READONLY,
+	NVS_READWRITE
+} nvs_open_mode_t;
+
+esp_err_t nvs_open(const char *name, nvs_open_mode_t open_mode, nvs_handle_t *out_handle);
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char *key, void *out_value, size_t *length);
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key, const void *value, size_t length);
+esp_err_t nvs_commit(nvs_handle_t handle);
+void nvs_close(nvs_handle_t handle);
@@ -0,0 +1,4 @@
+/* Host mock of the generated sdkconfig.h */
+#pragma once
+
+#define CONFIG_IDF_TARGET_ESP32C6	1
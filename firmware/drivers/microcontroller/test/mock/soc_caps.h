@@ -0,0 +1,10 @@
+/* Host mock of the ESP32-C6 soc_caps.h ADC capabilities */
+#pragma once
+
+#define SOC_ADC_DIGI_MAX_BITWIDTH			12
+#define SOC_ADC_DIGI_RESULT_BYTES			4
+#define SOC_ADC_DIGI_DATA_BYTES_PER_CONV	4
+#define SOC_ADC_SAMPLE_FREQ_THRES_LOW		611
+#define SOC_ADC_SAMPLE_FREQ_THRES_HIGH		83333
+#define SOC_ADC_PATT_LEN_MAX				8
+#define SOC_ADC_CHANNEL_NUM(unit)			7
@@ -0,0 +1,419 @@
+/**
+ * @file test_analog_io_mcu.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test of the analog IO driver against the mocks of the ESP-IDF ADC,
+ * calibration and NVS APIs (mock/): continuous frames, scan mode, scan list checks, scan
+ * coherence while the ISR writes, re-initialization, calibration tables and oversampling
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include "analog_io_mcu.h"
+#include "esp_adc/adc_cali_scheme.h"
+#include "nvs.h"
+#include "mock_idf.h"
+/*==================[macros and definitions]=================================*/
+#define CHECK(cond)	do{ if(!(cond)){ printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); errors++; } }while(0)
+/*==================[internal data declaration]==============================*/
+/* Driver state (white box) */
+extern uint16_t *adc_cali_table[];
+extern adc_cali_handle_t adc_calibration[];
+/*==================[internal data definition]===============================*/
+static int frames_done;					/*!< Frames notified by func_p */
+static uint16_t frame[256];
+static int frame_errors;
+static uint16_t *protected_values;		/*!< Output buffer that triggers the "ISR" when written */
+static int isr_frames;					/*!< Frames converted by the "ISR" */
+/*==================[internal functions definition]==========================*/
+/* Calibration tables are lost on reboot (NVS is kept) */
+static void SimulateReboot(void){
+	for(uint8_t ch=CH0; ch<=CH3; ch++){
+		free(adc_cali_table[ch]);
+		adc_cali_table[ch] = NULL;
+	}
+}
+
+/* Raw value of the continuous mode conversion k of CH1, checked from func_p (ISR context) */
+static void FrameDone(void *param){
+	frames_done++;
+	uint16_t n = AnalogInputReadContinuous(CH1, frame);
+	if(n != 128){
+		frame_errors++;
+	}
+	for(uint16_t i=0; i<n; i++){
+		if(frame[i] != mock_value((frames_done - 1) * 128 + i, CH1)){
+			frame_errors++;
+		}
+	}
+}
+
+/* Index of the conversion that read v: inverse of mock_value() for CH0 (7 * 3511 = 1 mod 4096) */
+static uint32_t MockIndex(uint16_t v){
+	return (v * 3511u) & 0xFFF;
+}
+
+/* The copy of AnalogInputReadScan() stores into a write protected buffer: frames arrive from
+ * the fault handler, like the ADC ISR preempting the task in the middle of the copy */
+static void ScanIsr(int sig, siginfo_t *info, void *context){
+	mprotect(protected_values, 4096, PROT_READ | PROT_WRITE);
+	mock_adc_run_frames(isr_frames);
+}
+
+/* Reference decimation: order cascaded moving sums of os samples, one output every os
+ * inputs, scaled to raw * 16 */
+static void Decimate(const int64_t *x, int lenght, int os, int order, double *out){
+	static int64_t a[1 << 14], b[1 << 14];
+	memcpy(a, x, lenght * sizeof(int64_t));
+	for(int n=0; n<order; n++){
+		for(int i=0; i<lenght; i++){
+			int64_t sum = 0;
+			for(int k=0; (k<os) && (i-k>=0); k++){
+				sum += a[i - k];
+			}
+			b[i] = sum;
+		}
+		memcpy(a, b, lenght * sizeof(int64_t));
+	}
+	for(int m=0; m<lenght/os; m++){
+		out[m] = a[m * os + os - 1] * 16.0 / pow(os, order);
+	}
+}
+
+static int TestCalibration(void){
+	int errors = 0;
+	uint16_t value;
+	int mv;
+
+	// First boot: table built from the calibration curve and stored in NVS
+	analog_input_config_t single = {.input = CH1, .mode = ADC_SINGLE, .cali_nvs = true};
+	mock_cali_calls = 0;
+	AnalogInputInit(&single);
+	CHECK((mock_cali_calls == 4096) && (mock_nvs_sets == 1));
+	// Single reads converted with the table
+	for(int raw=0; raw<4096; raw+=37){
+		mock_oneshot_value[CH1] = raw;
+		AnalogInputReadSingle(CH1, &value);
+		adc_cali_raw_to_voltage(adc_calibration[CH1], raw, &mv);
+		CHECK(value == mv);
+	}
+	uint16_t saved[4096];
+	memcpy(saved, adc_cali_table[CH1], sizeof(saved));
+	// Next boot: table read from NVS
+	SimulateReboot();
+	mock_cali_calls = 0;
+	AnalogInputInit(&single);
+	CHECK(mock_cali_calls == 0);
+	CHECK(memcmp(saved, adc_cali_table[CH1], sizeof(saved)) == 0);
+	// NVS not available: table built in RAM, partition never erased
+	mock_nvs_init_ret = ESP_ERR_NVS_NO_FREE_PAGES;
+	analog_input_config_t no_nvs = {.input = CH2, .mode = ADC_SINGLE, .cali_nvs = true};
+	mock_cali_calls = 0;
+	AnalogInputInit(&no_nvs);
+	CHECK((adc_cali_table[CH2] != NULL) && (mock_cali_calls == 4096));
+	CHECK((mock_nvs_erases == 0) && (mock_nvs_sets == 1));
+	mock_nvs_init_ret = ESP_OK;
+	// Buffers converted with one lookup per sample
+	static uint16_t raw[4096], mv_u16[4096];
+	static float mv_f32[4096];
+	for(int i=0; i<4096; i++){
+		raw[i] = (i * 2654435761u) >> 20;
+	}
+	CHECK(AnalogInputConvert(CH2, raw, mv_u16, 4096));
+	CHECK(AnalogInputConvertFloat(CH1, raw, mv_f32, 4096));
+	for(int i=0; i<4096; i++){
+		CHECK(mv_u16[i] == adc_cali_table[CH2][raw[i]]);
+		CHECK(mv_f32[i] == (float)adc_cali_table[CH1][raw[i]]);
+	}
+	CHECK(!AnalogInputConvert(CH3, raw, mv_u16, 10));
+	printf("  calibration: built and stored, read back from NVS, RAM only without NVS (no erase)\n");
+	return errors;
+}
+
+static int TestContinuous(void){
+	int errors = 0;
+	uint16_t values[128];
+
+	analog_input_config_t config = {.input = CH1, .mode = ADC_CONTINUOUS, .func_p = FrameDone,
+		.sample_frec = 20000, .frame_lenght = 128};
+	AnalogInputInit(&config);
+	CHECK(AnalogInputReadContinuous(CH1, values) == 0);
+	frames_done = 0;
+	frame_errors = 0;
+	AnalogStartContinuous(CH1);
+	mock_adc_run_frames(10);
+	AnalogStopContinuous(CH1);
+	CHECK((frames_done == 10) && (frame_errors == 0));
+	// Read late: the last complete frame is returned
+	CHECK(AnalogInputReadContinuous(CH1, values) == 128);
+	CHECK(values[0] == mock_value(9 * 128, CH1));
+	printf("  continuous: %d frames of 128 samples read from func_p, %d errors\n", frames_done, frame_errors);
+	return errors;
+}
+
+static int TestScan(void){
+	int errors = 0;
+	const adc_ch_t list[3] = {CH2, CH0, CH3};
+	static uint16_t a[300], b[300], c[300];
+	uint16_t *values[3] = {a, b, c};
+	static int64_t timestamps[300];
+	uint32_t scan = 0;
+
+	analog_input_config_t config = {.mode = ADC_SCAN, .sample_frec = 1000, .frame_lenght = 64,
+		.scan_list = list, .scan_lenght = 3, .buffer_lenght = 256};
+	AnalogInputInit(&config);
+	AnalogStartContinuous(CH0);
+	uint32_t overruns = AnalogInputScanOverruns();
+	for(int f=0; f<3; f++){
+		mock_time_us += 64000;
+		mock_adc_run_frames(1);
+	}
+	// De-interleaved channels, timestamps one scan period (1 ms) apart ending at the frame ISR
+	uint16_t n = AnalogInputReadScan(values, timestamps, 300);
+	CHECK(n == 192);
+	int64_t frame_end = mock_time_us - 2 * 64000;
+	for(uint16_t i=0; i<n; i++, scan++){
+		for(uint8_t j=0; j<3; j++){
+			CHECK(values[j][i] == mock_value(scan * 3 + j, list[j]));
+		}
+		CHECK(timestamps[i] == frame_end + 64000 * (scan / 64) - (63 - scan % 64) * 1000);
+	}
+	// Overrun: 5 frames (320 scans) into 256 scans, the 64 oldest are lost
+	for(int f=0; f<5; f++){
+		mock_time_us += 64000;
+		mock_adc_run_frames(1);
+	}
+	n = AnalogInputReadScan(values, NULL, 300);
+	CHECK((n == 256) && (AnalogInputScanOverruns() - overruns == 64));
+	scan += 64;
+	for(uint16_t i=0; i<n; i++, scan++){
+		for(uint8_t j=0; j<3; j++){
+			CHECK(values[j][i] == mock_value(scan * 3 + j, list[j]));
+		}
+	}
+	CHECK(AnalogInputReadScan(values, timestamps, 10) == 0);
+	AnalogStopContinuous(CH0);
+	printf("  scan: 3 channels de-interleaved with timestamps, 64 scans overrun counted\n");
+	return errors;
+}
+
+static int TestScanList(void){
+	int errors = 0;
+	const adc_ch_t repeated[2] = {CH0, CH0};
+	const adc_ch_t out_of_range[2] = {CH1, (adc_ch_t)7};
+	const adc_ch_t all[4] = {CH3, CH2, CH1, CH0};
+
+	// Running scan, not replaced by the invalid lists
+	analog_input_config_t config = {.mode = ADC_SCAN, .sample_frec = 1000, .scan_list = all, .scan_lenght = 4};
+	AnalogInputInit(&config);
+	int deinit_calls = mock_deinit_calls;
+	config.scan_list = repeated;
+	config.scan_lenght = 2;
+	AnalogInputInit(&config);
+	config.scan_list = out_of_range;
+	AnalogInputInit(&config);
+	config.scan_list = NULL;
+	AnalogInputInit(&config);
+	CHECK(mock_deinit_calls == deinit_calls);
+	printf("  scan list: repeated and out of range inputs rejected\n");
+	return errors;
+}
+
+static int TestScanCoherence(void){
+	int errors = 0;
+	const adc_ch_t list[2] = {CH0, CH2};
+	static uint16_t b[32];
+	int64_t timestamps[32];
+	struct sigaction action = {0};
+
+	protected_values = mmap(NULL, 4096, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	uint16_t *values[2] = {protected_values, b};
+	action.sa_sigaction = ScanIsr;
+	action.sa_flags = SA_SIGINFO;
+	sigaction(SIGSEGV, &action, NULL);
+	for(isr_frames=1; isr_frames<=3; isr_frames++){
+		analog_input_config_t config = {.mode = ADC_SCAN, .sample_frec = 1000, .frame_lenght = 16,
+			.scan_list = list, .scan_lenght = 2, .buffer_lenght = 32};
+		AnalogInputInit(&config);
+		AnalogStartContinuous(CH0);
+		uint32_t overruns = AnalogInputScanOverruns();
+		// Buffer full, then isr_frames frames arrive during the copy
+		mock_adc_run_frames(2);
+		mprotect(protected_values, 4096, PROT_READ);
+		uint32_t read = 0;
+		for(int r=0; r<2; r++){
+			uint16_t n = AnalogInputReadScan(values, timestamps, 32);
+			for(uint16_t i=0; i<n; i++){
+				// Both channels from the same scan
+				uint32_t k = MockIndex(values[0][i]);
+				CHECK(((k & 1) == 0) && (values[1][i] == mock_value(k + 1, CH2)));
+			}
+			read += n;
+		}
+		CHECK(read + (AnalogInputScanOverruns() - overruns) == 32 + 16 * isr_frames);
+		printf("  scan coherence, %d frame(s) during the copy: %lu scans read, %lu overruns\n",
+			isr_frames, (unsigned long)read, (unsigned long)(AnalogInputScanOverruns() - overruns));
+		AnalogStopContinuous(CH0);
+	}
+	signal(SIGSEGV, SIG_DFL);
+	munmap(protected_values, 4096);
+	return errors;
+}
+
+static int TestReinit(void){
+	int errors = 0;
+	uint16_t values[256];
+	const adc_ch_t list[2] = {CH0, CH3};
+	static uint16_t a[64], b[64];
+	uint16_t *scan_values[2] = {a, b};
+	int64_t timestamps[64];
+
+	analog_input_config_t continuous = {.input = CH1, .mode = ADC_CONTINUOUS, .sample_frec = 1000};
+	AnalogInputInit(&continuous);
+	AnalogStartContinuous(CH1);
+	mock_adc_run_frames(1);
+	int deinit_calls = mock_deinit_calls;
+	// Continuous to continuous while running (other input and frame)
+	analog_input_config_t other = {.input = CH2, .mode = ADC_CONTINUOUS, .sample_frec = 2000, .frame_lenght = 64};
+	AnalogInputInit(&other);
+	AnalogStartContinuous(CH2);
+	mock_adc_run_frames(1);
+	CHECK(AnalogInputReadContinuous(CH2, values) == 64);
+	for(uint16_t i=0; i<64; i++){
+		CHECK(values[i] == mock_value(i, CH2));
+	}
+	// Continuous to scan
+	analog_input_config_t scan = {.mode = ADC_SCAN, .sample_frec = 1000, .frame_lenght = 32,
+		.scan_list = list, .scan_lenght = 2, .buffer_lenght = 128};
+	AnalogInputInit(&scan);
+	AnalogStartContinuous(CH0);
+	mock_adc_run_frames(2);
+	CHECK(AnalogInputReadScan(scan_values, timestamps, 64) == 64);
+	for(uint16_t m=0; m<64; m++){
+		CHECK((a[m] == mock_value(2 * m, CH0)) && (b[m] == mock_value(2 * m + 1, CH3)));
+	}
+	// Scan to continuous, stopped
+	AnalogStopContinuous(CH0);
+	AnalogInputInit(&continuous);
+	AnalogStartContinuous(CH1);
+	mock_adc_run_frames(1);
+	CHECK(AnalogInputReadContinuous(CH1, values) == 256);
+	CHECK(mock_deinit_calls - deinit_calls == 3);
+	AnalogStopContinuous(CH1);
+	printf("  re-initialization: continuous -> continuous -> scan -> continuous, previous handle released\n");
+	return errors;
+}
+
+static int TestOversamplingContinuous(uint8_t os, adc_decimation_t decimation, int order){
+	int errors = 0;
+	static int64_t conversions[1 << 14];
+	static double reference[4096];
+	static uint16_t outputs[4096];
+	int frame_lenght = 256 / os;
+	int frames = 8;
+	int n_outputs = 0;
+
+	analog_input_config_t config = {.input = CH1, .mode = ADC_CONTINUOUS, .sample_frec = 1000,
+		.oversampling = os, .decimation = decimation};
+	AnalogInputInit(&config);
+	AnalogStartContinuous(CH1);
+	for(int f=0; f<frames; f++){
+		mock_adc_run_frames(1);
+		uint16_t n = AnalogInputReadContinuous(CH1, &outputs[n_outputs]);
+		CHECK(n == frame_lenght);
+		n_outputs += n;
+	}
+	AnalogStopContinuous(CH1);
+	for(int k=0; k<frame_lenght * os * frames; k++){
+		conversions[k] = mock_value(k, CH1);
+	}
+	Decimate(conversions, frame_lenght * os * frames, os, order, reference);
+	double max_error = 0;
+	for(int i=0; i<n_outputs; i++){
+		max_error = fmax(max_error, fabs(outputs[i] - reference[i]));
+	}
+	// Integer filters round to the nearest LSB / 16
+	CHECK(max_error < 1.0);
+	printf("  continuous x%d %s: %d outputs, max |error| vs reference %.3f LSB/16\n",
+		os, (decimation == ADC_DECIMATION_CIC) ? "CIC" : "boxcar", n_outputs, max_error);
+	return errors;
+}
+
+static int TestOversampling(void){
+	int errors = 0;
+	const adc_ch_t list[2] = {CH3, CH0};
+	uint16_t a[64], b[64];
+	uint16_t *values[2] = {a, b};
+	int64_t timestamps[64];
+
+	errors += TestOversamplingContinuous(8, ADC_DECIMATION_BOXCAR, 1);
+	errors += TestOversamplingContinuous(16, ADC_DECIMATION_BOXCAR, 1);
+	errors += TestOversamplingContinuous(2, ADC_DECIMATION_CIC, 3);
+	errors += TestOversamplingContinuous(4, ADC_DECIMATION_CIC, 3);
+	errors += TestOversamplingContinuous(16, ADC_DECIMATION_CIC, 3);
+	// Scan of 2 channels, x4 boxcar: sum of 4 conversions (mean * 16 = sum * 4)
+	analog_input_config_t scan = {.mode = ADC_SCAN, .sample_frec = 1000, .frame_lenght = 32,
+		.scan_list = list, .scan_lenght = 2, .buffer_lenght = 256, .oversampling = 4};
+	AnalogInputInit(&scan);
+	AnalogStartContinuous(CH0);
+	mock_adc_run_frames(2);
+	uint16_t n = AnalogInputReadScan(values, timestamps, 64);
+	CHECK(n == 64);
+	for(uint16_t m=0; m<n; m++){
+		for(uint8_t j=0; j<2; j++){
+			uint32_t sum = 0;
+			for(uint32_t r=0; r<4; r++){
+				sum += mock_value((m * 4 + r) * 2 + j, list[j]);
+			}
+			CHECK(values[j][m] == sum * 4);
+		}
+	}
+	// Invalid settings rejected before the running configuration is released
+	int deinit_calls = mock_deinit_calls;
+	analog_input_config_t not_power_of_two = {.input = CH1, .mode = ADC_CONTINUOUS, .sample_frec = 1000, .oversampling = 3};
+	AnalogInputInit(&not_power_of_two);
+	analog_input_config_t too_fast = {.input = CH1, .mode = ADC_CONTINUOUS, .sample_frec = 10000, .oversampling = 16};
+	AnalogInputInit(&too_fast);
+	CHECK(mock_deinit_calls == deinit_calls);
+	AnalogStopContinuous(CH0);
+	// Oversampled values (4 fractional bits) converted with interpolation between table entries
+	const uint16_t raw[5] = {0, 2048 * 16, 2048 * 16 + 8, 4095 * 16, 1000 * 16 + 15};
+	float mv_f32[5];
+	uint16_t mv_u16[5];
+	AnalogInputConvertFloat(CH1, raw, mv_f32, 5);
+	AnalogInputConvert(CH1, raw, mv_u16, 5);
+	const uint16_t *table = adc_cali_table[CH1];
+	for(int i=0; i<5; i++){
+		int code = raw[i] >> 4;
+		int next = (code + 1 > 4095) ? 4095 : code + 1;
+		double expected = table[code] + (table[next] - table[code]) * (raw[i] & 15) / 16.0;
+		CHECK(fabs(mv_f32[i] - expected) < 1e-3);
+		CHECK(abs(mv_u16[i] - (int)lround(expected)) <= 1);
+	}
+	printf("  scan x4 boxcar, invalid settings and interpolated conversion checked\n");
+	return errors;
+}
+/*==================[external functions definition]==========================*/
+int test_analog_io_mcu(void){
+	int errors = 0;
+	printf("analog_io_mcu\n");
+	errors += TestCalibration();
+	errors += TestContinuous();
+	errors += TestScan();
+	errors += TestScanList();
+	errors += TestScanCoherence();
+	errors += TestReinit();
+	errors += TestOversampling();
+	return errors;
+}
+
+/*==================[end of file]============================================*/
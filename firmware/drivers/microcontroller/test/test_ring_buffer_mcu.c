@@ -0,0 +1,229 @@
+/**
+ * @file test_ring_buffer_mcu.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test of the SPSC ring buffer: single thread cases (overruns, wrap around
+ * spans) and producer / consumer threads (the producer plays the ISR)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <pthread.h>
+#include <sched.h>
+#include "ring_buffer_mcu.h"
+/*==================[macros and definitions]=================================*/
+#define TEST_SAMPLES	2000000		/*!< Samples passed between threads in each test */
+#define BLOCK_LENGHT	37			/*!< Block written at once (not a divisor of the buffer lenght) */
+
+#define CHECK(cond)	do{ if(!(cond)){ printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); errors++; } }while(0)
+/*==================[internal data definition]===============================*/
+static int16_t i16_storage[256];
+static ring_buffer_i16_t i16_ring;
+static float f32_storage[1024];
+static ring_buffer_f32_t f32_ring;
+static uint16_t u16_storage[64];
+static ring_buffer_u16_t u16_ring;
+static uint32_t producer_done;		/*!< Set (release) by the producer when it's finished */
+static uint32_t produced;			/*!< Samples offered by the producer (stored or dropped) */
+/*==================[internal functions definition]==========================*/
+/* Producer of one sample at a time, retrying while the buffer is full */
+static void *ProducerSample(void *param){
+	for(uint32_t k=0; k<TEST_SAMPLES; ){
+		if(RingBufferI16Write(&i16_ring, (int16_t)k)){
+			k++;
+		}
+		else{
+			sched_yield();
+		}
+	}
+	__atomic_store_n(&producer_done, 1, __ATOMIC_RELEASE);
+	return NULL;
+}
+
+/* Producer of blocks, retrying the samples that didn't fit */
+static void *ProducerBlock(void *param){
+	float values[BLOCK_LENGHT];
+	for(uint32_t k=0; k<TEST_SAMPLES; ){
+		uint32_t n = (TEST_SAMPLES - k < BLOCK_LENGHT) ? TEST_SAMPLES - k : BLOCK_LENGHT;
+		for(uint32_t j=0; j<n; j++){
+			values[j] = (float)((k + j) & 0xFFFF);
+		}
+		uint32_t stored = RingBufferF32WriteBlock(&f32_ring, values, n);
+		k += stored;
+		if(stored < n){
+			sched_yield();
+		}
+	}
+	__atomic_store_n(&producer_done, 1, __ATOMIC_RELEASE);
+	return NULL;
+}
+
+/* Producer that never waits, like an ISR: samples that don't fit are dropped */
+static void *ProducerDrop(void *param){
+	float values[BLOCK_LENGHT];
+	uint32_t k = 0;
+	while(k < TEST_SAMPLES){
+		for(uint32_t j=0; j<BLOCK_LENGHT; j++){
+			values[j] = (float)(k + j);
+		}
+		RingBufferF32WriteBlock(&f32_ring, values, BLOCK_LENGHT);
+		k += BLOCK_LENGHT;
+		// Let the consumer run (single core hosts) without waiting for it
+		if((k % (4 * BLOCK_LENGHT)) == 0){
+			sched_yield();
+		}
+	}
+	produced = k;
+	__atomic_store_n(&producer_done, 1, __ATOMIC_RELEASE);
+	return NULL;
+}
+
+static int TestSingleThread(void){
+	int errors = 0;
+	uint16_t values[64];
+	ring_buffer_u16_span_t span[2];
+
+	CHECK(!RingBufferI16Init(&i16_ring, i16_storage, 100));
+	CHECK(!RingBufferI16Init(&i16_ring, i16_storage, 0));
+	CHECK(RingBufferU16Init(&u16_ring, u16_storage, 64));
+	// Overrun: the 6 newest samples are dropped, never the ones the consumer may be reading
+	for(uint16_t i=0; i<70; i++){
+		RingBufferU16Write(&u16_ring, i);
+	}
+	CHECK(RingBufferU16Available(&u16_ring) == 64);
+	CHECK(RingBufferU16Overruns(&u16_ring) == 6);
+	CHECK(RingBufferU16Read(&u16_ring, values, 50) == 50);
+	for(uint16_t i=0; i<50; i++){
+		CHECK(values[i] == i);
+	}
+	// Wrap around: 14 samples before the end of the storage and 30 from its start
+	for(uint16_t i=70; i<100; i++){
+		RingBufferU16Write(&u16_ring, i);
+	}
+	CHECK(RingBufferU16Peek(&u16_ring, span) == 44);
+	CHECK((span[0].lenght == 14) && (span[1].lenght == 30));
+	CHECK(span[1].data == u16_storage);
+	for(uint32_t i=0; i<span[0].lenght; i++){
+		CHECK(span[0].data[i] == 50 + i);
+	}
+	for(uint32_t i=0; i<span[1].lenght; i++){
+		CHECK(span[1].data[i] == 70 + i);
+	}
+	CHECK(RingBufferU16Consume(&u16_ring, 100) == 44);
+	CHECK(RingBufferU16Available(&u16_ring) == 0);
+	// Block write split by the end of the storage, read back across it
+	uint16_t block[40];
+	for(uint16_t i=0; i<40; i++){
+		block[i] = 1000 + i;
+	}
+	CHECK(RingBufferU16WriteBlock(&u16_ring, block, 40) == 40);
+	CHECK(RingBufferU16Read(&u16_ring, values, 64) == 40);
+	for(uint16_t i=0; i<40; i++){
+		CHECK(values[i] == 1000 + i);
+	}
+	printf("  single thread: overruns, wrap around spans and block split checked\n");
+	return errors;
+}
+
+static int TestSampleWriterBatchReader(void){
+	int errors = 0;
+	int16_t values[100];
+	uint32_t expected = 0;
+	pthread_t producer;
+
+	RingBufferI16Init(&i16_ring, i16_storage, 256);
+	__atomic_store_n(&producer_done, 0, __ATOMIC_RELAXED);
+	pthread_create(&producer, NULL, ProducerSample, NULL);
+	while(!__atomic_load_n(&producer_done, __ATOMIC_ACQUIRE) || (RingBufferI16Available(&i16_ring) > 0)){
+		uint32_t n = RingBufferI16Read(&i16_ring, values, 100);
+		for(uint32_t i=0; i<n; i++, expected++){
+			if(values[i] != (int16_t)expected){
+				errors++;
+			}
+		}
+	}
+	pthread_join(producer, NULL);
+	CHECK(expected == TEST_SAMPLES);
+	printf("  sample writer / batch reader: %lu samples in order, %lu retried writes, %d errors\n",
+		(unsigned long)expected, (unsigned long)RingBufferI16Overruns(&i16_ring), errors);
+	return errors;
+}
+
+static int TestBlockWriterPeekConsume(void){
+	int errors = 0;
+	uint32_t expected = 0;
+	uint32_t splits = 0;
+	pthread_t producer;
+
+	RingBufferF32Init(&f32_ring, f32_storage, 1024);
+	__atomic_store_n(&producer_done, 0, __ATOMIC_RELAXED);
+	pthread_create(&producer, NULL, ProducerBlock, NULL);
+	while(expected < TEST_SAMPLES){
+		ring_buffer_f32_span_t span[2];
+		RingBufferF32Peek(&f32_ring, span);
+		if(span[1].lenght > 0){
+			splits++;
+		}
+		// Only part of the samples is consumed each time, so reads start anywhere in the storage
+		uint32_t n = 0;
+		for(uint8_t s=0; s<2; s++){
+			for(uint32_t i=0; (i<span[s].lenght) && (n<BLOCK_LENGHT * 3); i++, n++, expected++){
+				if(span[s].data[i] != (float)(expected & 0xFFFF)){
+					errors++;
+				}
+			}
+		}
+		CHECK(RingBufferF32Consume(&f32_ring, n) == n);
+		// Let the producer refill the freed space (single core hosts)
+		sched_yield();
+	}
+	pthread_join(producer, NULL);
+	CHECK(splits > 0);
+	printf("  block writer / peek + consume: %lu samples in order, %lu wrap around peeks, %d errors\n",
+		(unsigned long)expected, (unsigned long)splits, errors);
+	return errors;
+}
+
+static int TestOverrunCount(void){
+	int errors = 0;
+	uint32_t received = 0;
+	float last = -1.0f;
+	float values[64];
+	pthread_t producer;
+
+	RingBufferF32Init(&f32_ring, f32_storage, 128);
+	__atomic_store_n(&producer_done, 0, __ATOMIC_RELAXED);
+	pthread_create(&producer, NULL, ProducerDrop, NULL);
+	while(!__atomic_load_n(&producer_done, __ATOMIC_ACQUIRE) || (RingBufferF32Available(&f32_ring) > 0)){
+		uint32_t n = RingBufferF32Read(&f32_ring, values, 64);
+		for(uint32_t i=0; i<n; i++){
+			// Samples may be missing (dropped) but never repeated nor out of order
+			if(values[i] <= last){
+				errors++;
+			}
+			last = values[i];
+		}
+		received += n;
+	}
+	pthread_join(producer, NULL);
+	CHECK(received + RingBufferF32Overruns(&f32_ring) == produced);
+	printf("  dropping writer: %lu samples = %lu received + %lu overruns, %d errors\n",
+		(unsigned long)produced, (unsigned long)received, (unsigned long)RingBufferF32Overruns(&f32_ring), errors);
+	return errors;
+}
+/*==================[external functions definition]==========================*/
+int test_ring_buffer_mcu(void){
+	int errors = 0;
+	printf("ring_buffer_mcu\n");
+	errors += TestSingleThread();
+	errors += TestSampleWriterBatchReader();
+	errors += TestBlockWriterPeekConsume();
+	errors += TestOverrunCount();
+	return errors;
+}
+
+/*==================[end of file]============================================*/
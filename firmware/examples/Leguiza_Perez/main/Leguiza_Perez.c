@@ -15,6 +15,7 @@
  * | 22/10/2025 | Código adaptado a EMG real con buffer circular |
  * | 28/10/2025 | Se agrega detección de fatiga mediante FFT     |
  * | 5/11/2025  | Se modifica codigo de la interfase             |
+ * | 16/10/2026 | Muestreo por DMA con sobremuestreo x16 (CIC)   |
  *
  * @authors 
  * Florencia Ailen Leguiza Scandizzo  
@@ -36,18 +37,22 @@
 #include "delay_mcu.h"
 
 #include "fft.h"
+#include "spectral_features.h"
 #include "iir_filter.h"
 
 #include "analog_io_mcu.h"
-#include "timer_mcu.h"
+#include "ring_buffer_mcu.h"
 
 /==================[macros and definitions]=================================/
 #define CONFIG_BLINK_PERIOD 500
 #define LED_BT	            LED_1
 #define BUFFER_SIZE         512     // Ventana FFT
-#define EMG_BUFFER_LEN      512    // Buffer circular
+#define EMG_BUFFER_LEN      1024    // Buffer circular (potencia de 2)
+#define EMG_TRIM_PERIOD     500     // ms entre descartes de muestras viejas
 #define SAMPLE_FREQ	        512     // Hz
 #define ADC_CH_EMG          CH1
+#define EMG_OVERSAMPLING    16      // Conversiones por muestra (ADC a 8192 Hz)
+#define EMG_FRAME_LEN       64      // Muestras por frame del ADC (125 ms)
 
 // Parámetros de detección de fatiga
 #define FATIGUE_THRESHOLD     0.15f   // 15% de descenso
@@ -55,15 +60,20 @@
 #define CONSECUTIVE_WINDOWS   3       // Ventanas consecutivas necesarias
 
 /==================[internal data definition]===============================/
-static float emg_buffer[EMG_BUFFER_LEN];   // buffer circular para EMG
-static uint16_t write_index = 0;
-static uint16_t sample_count = 0;
+static float emg_buffer[EMG_BUFFER_LEN];   // almacenamiento del buffer circular EMG
+static ring_buffer_f32_t emg_ring;          // buffer circular ISR -> tarea EMG
+static uint16_t emg_frame[EMG_FRAME_LEN];   // frame del ADC (sobremuestreado)
+static float emg_frame_mv[EMG_FRAME_LEN];   // frame del ADC en mV
 
 static float emg_window[BUFFER_SIZE];       // ventana para FFT
 static float emg_filt[BUFFER_SIZE];
 static float emg_fft[BUFFER_SIZE/2];
 static float emg_filt_fft[BUFFER_SIZE/2];
 static float f[BUFFER_SIZE/2];
+static fft_plan_t emg_fft_plan;             // plan FFT (ventana Hann precalculada)
+static spectral_ctx_t emg_spectral;         // contexto de métricas espectrales
+static iir_filter_t emg_hp;                 // filtro pasa altos de la señal EMG
+static iir_filter_t emg_lp;                 // filtro pasa bajos de la señal EMG
 
 TaskHandle_t emg_task_handle = NULL;
 
@@ -104,18 +114,16 @@ void read_data(uint8_t * data, uint8_t length){
 
 
 /**
- * @brief Escribe una muestra nueva en el buffer circular EMG.
+ * @brief Descarta las muestras más viejas del buffer circular, dejando las
+ *        últimas BUFFER_SIZE.
  *
- * Guarda la muestra en la posición actual y avanza el índice de escritura.
- * Si el buffer aún no está lleno, incrementa el contador de muestras válidas.
- *
- * @param sample Valor leído del ADC (señal EMG).
+ * El ISR descarta las muestras nuevas si el buffer está lleno, por lo que
+ * la tarea debe llamarla periódicamente para que la ventana sea la más reciente.
  */
-static void CircularBufferWrite(float sample){
-    emg_buffer[write_index] = sample;
-    write_index = (write_index + 1) % EMG_BUFFER_LEN;
-    if(sample_count < EMG_BUFFER_LEN){
-        sample_count++;
+static void CircularBufferTrim(void){
+    uint32_t available = RingBufferF32Available(&emg_ring);
+    if(available > BUFFER_SIZE){
+        RingBufferF32Consume(&emg_ring, available - BUFFER_SIZE);
     }
 }
 
@@ -123,16 +131,27 @@ static void CircularBufferWrite(float sample){
  * @brief Copia las últimas BUFFER_SIZE muestras desde el buffer circular
  *        hacia una ventana temporal para el procesamiento FFT.
  *
+ * Las muestras quedan en el buffer (las ventanas se solapan).
+ *
  * @param window Puntero al arreglo destino donde se copiarán las muestras.
  */
 static void CircularBufferReadWindow(float *window){
-    if(sample_count < BUFFER_SIZE) {
+    ring_buffer_f32_span_t span[2];
+    CircularBufferTrim();
+    uint32_t available = RingBufferF32Peek(&emg_ring, span);
+    if(available < BUFFER_SIZE) {
         return;
     }
-    // Calcular inicio de las últimas BUFFER_SIZE muestras
-    uint16_t start = (write_index - BUFFER_SIZE + EMG_BUFFER_LEN) % EMG_BUFFER_LEN;
-    for(int i = 0; i < BUFFER_SIZE; i++){
-        window[i] = emg_buffer[(start + i) % EMG_BUFFER_LEN];
+    // El ISR pudo agregar muestras después del descarte: se saltean las más viejas
+    // para que la ventana sean las últimas BUFFER_SIZE (en uno o dos tramos contiguos)
+    uint32_t skip = available - BUFFER_SIZE;
+    if(skip < span[0].lenght){
+        uint32_t first = span[0].lenght - skip;
+        memcpy(window, &span[0].data[skip], first * sizeof(float));
+        memcpy(&window[first], span[1].data, (BUFFER_SIZE - first) * sizeof(float));
+    }
+    else{
+        memcpy(window, &span[1].data[skip - span[0].lenght], BUFFER_SIZE * sizeof(float));
     }
 }
 
@@ -154,48 +173,6 @@ static float CalcRMS(float *data, int len){
     return sqrtf(sum / len);
 }
 
-/**
- * @brief Calcula la frecuencia media ponderada del espectro.
- *
- * Representa el centro de masa espectral y tiende a disminuir con la fatiga.
- *
- * @param fft_mag Vector de magnitudes espectrales.
- * @param freqs   Vector de frecuencias correspondientes.
- * @param len     Longitud de los vectores (BUFFER_SIZE/2).
- * @return Frecuencia media (Hz).
- */
-static float CalcMeanFreq(float *fft_mag, float *freqs, int len){
-    float num = 0.0f, den = 0.0f;
-    for(int i=0; i<len; i++){
-        num += freqs[i] * fft_mag[i];
-        den += fft_mag[i];
-    }
-    return (den > 0) ? num / den : 0.0f;
-}
-
-/**
- * @brief Calcula la frecuencia mediana del espectro.
- *
- * Divide el área espectral en dos mitades iguales de energía.
- * Es una métrica robusta para estimar la fatiga muscular.
- *
- * @param fft_mag Vector de magnitudes espectrales.
- * @param freqs   Vector de frecuencias correspondientes.
- * @param len     Longitud de los vectores (BUFFER_SIZE/2).
- * @return Frecuencia mediana (Hz).
- */
-static float CalcMedianFreq(float *fft_mag, float *freqs, int len){
-    float total = 0.0f;
-    for(int i=0; i<len; i++) total += fft_mag[i];
-    float half = total / 2.0f;
-    float accum = 0.0f;
-    for(int i=0; i<len; i++){
-        accum += fft_mag[i];
-        if(accum >= half) return freqs[i];
-    }
-    return freqs[len - 1];
-}
-
 /**
  * @brief Tarea principal EMG: adquiere muestras, calcula FFT,
  *        obtiene métricas espectrales y detecta fatiga muscular.
@@ -209,22 +186,27 @@ static float CalcMedianFreq(float *fft_mag, float *freqs, int len){
  */
 static void EMGTask(void *pvParameter){
     char msg_ble[128];
+    spectral_features_t emg_features;
     static bool f_ref_established = false;  // ← Nueva bandera
     static float f_ref_accum = 0.0f;        // ← Acumulador temporal
 
     while(true){
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if(ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(EMG_TRIM_PERIOD)) == 0){
+            // Sin pedido: liberar lugar en el buffer para las muestras nuevas
+            CircularBufferTrim();
+            continue;
+        }
 
         // Tomar BUFFER_SIZE muestras desde buffer circular
         CircularBufferReadWindow(emg_window);
 
-        // Filtros
-        HiPassFilter(emg_window, emg_filt, BUFFER_SIZE);
-        LowPassFilter(emg_filt, emg_filt, BUFFER_SIZE);
+        // Filtros de fase cero (sin transitorios en los bordes de la ventana)
+        memcpy(emg_filt, emg_window, sizeof(emg_filt));
+        IirFiltFilt(&emg_hp, emg_filt, BUFFER_SIZE);
+        IirFiltFilt(&emg_lp, emg_filt, BUFFER_SIZE);
 
         // FFT
-        FFTMagnitude(emg_window, emg_fft, BUFFER_SIZE);
-        FFTMagnitude(emg_filt, emg_filt_fft, BUFFER_SIZE);
+        FFTPlanMagnitudeDual(&emg_fft_plan, emg_window, emg_filt, emg_fft, emg_filt_fft);
         FFTFrequency(SAMPLE_FREQ, BUFFER_SIZE, f);
 
         /==================[ANÁLISIS DE FATIGA Y ENVÍO BLE]=====================/
@@ -242,8 +224,9 @@ static void EMGTask(void *pvParameter){
 
         // Calcular métricas de la ventana
         rms_value = CalcRMS(emg_filt, BUFFER_SIZE);
-        f_mean    = CalcMeanFreq(emg_filt_fft, f, BUFFER_SIZE/2);
-        f_median  = CalcMedianFreq(emg_filt_fft, f, BUFFER_SIZE/2);
+        SpectralFeaturesCalc(&emg_spectral, emg_filt_fft, &emg_features);
+        f_mean    = emg_features.mean_freq;
+        f_median  = emg_features.median_freq;
 
         // Enviar métricas actuales por BLE
 
@@ -338,17 +321,17 @@ static void EMGTask(void *pvParameter){
 
 
 /**
- * @brief Rutina de interrupción del temporizador.
+ * @brief Rutina de interrupción de fin de frame del ADC.
  *
- * Se ejecuta a la frecuencia de muestreo definida y adquiere
- * una muestra analógica del canal EMG, almacenándola en el buffer circular.
+ * Se ejecuta cada EMG_FRAME_LEN muestras (ya decimadas por el driver),
+ * las convierte a mV y las almacena en el buffer circular.
  *
- * @param param Parámetro del temporizador (no utilizado).
+ * @param param Parámetro del callback (no utilizado).
  */
-void EMG_TimerISR(void *param){
-    uint16_t adc_val;
-    AnalogInputReadSingle(ADC_CH_EMG, &adc_val);
-    CircularBufferWrite((float)adc_val);
+void EMG_FrameISR(void *param){
+    uint16_t n = AnalogInputReadContinuous(ADC_CH_EMG, emg_frame);
+    AnalogInputConvertFloat(ADC_CH_EMG, emg_frame, emg_frame_mv, n);
+    RingBufferF32WriteBlock(&emg_ring, emg_frame_mv, n);
 }
 
 /**
@@ -362,8 +345,27 @@ void app_main(void){
     // Inicializaciones
     LedsInit();
     FFTInit();
-    LowPassInit(SAMPLE_FREQ, 30, ORDER_2);
-    HiPassInit(SAMPLE_FREQ, 1, ORDER_2);
+    FFTPlanInit(&emg_fft_plan, BUFFER_SIZE, FFT_WINDOW_HANN);
+    spectral_config_t spectral_config = {
+        .sample_freq = SAMPLE_FREQ,
+        .signal_lenght = BUFFER_SIZE,
+        .format = SPECTRAL_FLOAT,
+    };
+    SpectralFeaturesInit(&emg_spectral, &spectral_config);
+    iir_filter_config_t lp_config = {
+        .type = IIR_LOW_PASS,
+        .sample_frec = SAMPLE_FREQ,
+        .cut_frec = 30,
+        .order = ORDER_2
+    };
+    IirInit(&emg_lp, &lp_config);
+    iir_filter_config_t hp_config = {
+        .type = IIR_HI_PASS,
+        .sample_frec = SAMPLE_FREQ,
+        .cut_frec = 1,
+        .order = ORDER_2
+    };
+    IirInit(&emg_hp, &hp_config);
 
     // BLE
     ble_config_t ble_configuration = {
@@ -372,25 +374,23 @@ void app_main(void){
     };
     BleInit(&ble_configuration);
 
-    // ADC
+    // Buffer circular para muestras EMG
+    RingBufferF32Init(&emg_ring, emg_buffer, EMG_BUFFER_LEN);
+
+    // ADC por DMA: SAMPLE_FREQ * EMG_OVERSAMPLING conversiones por segundo,
+    // decimadas con filtro CIC a SAMPLE_FREQ (menos ruido que una lectura simple)
     analog_input_config_t adc_config = {
         .input = ADC_CH_EMG,
-        .mode = ADC_SINGLE,
-        .func_p = NULL,
+        .mode = ADC_CONTINUOUS,
+        .func_p = EMG_FrameISR,
         .param_p = NULL,
-        .sample_frec = SAMPLE_FREQ
+        .sample_frec = SAMPLE_FREQ,
+        .frame_lenght = EMG_FRAME_LEN,
+        .oversampling = EMG_OVERSAMPLING,
+        .decimation = ADC_DECIMATION_CIC
     };
     AnalogInputInit(&adc_config);
-
-    // Timer para muestreo EMG
-    timer_config_t emg_timer = {
-        .timer = TIMER_A,
-        .period = 1000000 / SAMPLE_FREQ, // en us
-        .func_p = EMG_TimerISR,
-        .param_p = NULL
-    };
-    TimerInit(&emg_timer);
-    TimerStart(TIMER_A);
+    AnalogStartContinuous(ADC_CH_EMG);
 
     // Tarea EMG
     xTaskCreate(&EMGTask, "EMG", 4096, NULL, 5, &emg_task_handle);
@@ -18,6 +18,7 @@
  * |   Date	    | Description                                    |
  * |:----------:|:-----------------------------------------------|
  * | 12/09/2023 | Document creation		                         |
+ * | 16/10/2026 | Low pass cut-off changed from BLE ("L<Hz>")     |
  *
  * @author Albano Peñalva (albano.penalva@uner.edu.ar)
  *
@@ -79,6 +80,18 @@ void read_data(uint8_t * data, uint8_t length){
         case 'a':
             filter = false;
             break;
+        case 'L':{
+            // Low pass cut-off frequency in Hz (e.g. "L15"), changed while FftTask is filtering
+            // Digits stop being added once the value is out of range (no uint16_t wrap around)
+            uint16_t cut_frec = 0;
+            for(uint8_t i=1; (i<length) && (data[i]>='0') && (data[i]<='9') && (cut_frec < SAMPLE_FREQ / 2); i++){
+                cut_frec = cut_frec * 10 + (data[i] - '0');
+            }
+            if((cut_frec > 0) && (cut_frec < SAMPLE_FREQ / 2)){
+                LowPassInit(SAMPLE_FREQ, cut_frec, ORDER_2);
+            }
+            break;
+        }
     }
 }
 
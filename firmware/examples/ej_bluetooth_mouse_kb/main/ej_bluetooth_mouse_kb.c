@@ -44,6 +44,12 @@
 #define CONFIG_BLINK_PERIOD 500
 #define DELAY_MEASURE       50
 #define LED_BT	            LED_1
+/* Umbrales del joystick en mV (AnalogInputReadSingle() devuelve mV, 0 a 3300 mV);
+ * equivalen a los códigos 50, 1000, 2300 y 3250 de 12 bits usados antes */
+#define JOY_FULL_NEG_MV     40
+#define JOY_NEG_MV          806
+#define JOY_POS_MV          1853
+#define JOY_FULL_POS_MV     2619
 /*==================[internal data definition]===============================*/
 TaskHandle_t joystick_task_handle = NULL;
 analog_input_config_t adc_x, adc_y;
@@ -79,13 +85,13 @@ void FuncTecJoy(void){
  * @return int8_t 
  */
 void UpdateMouse(int8_t * pos, uint16_t analog_data){
-    if(analog_data < 50){
+    if(analog_data < JOY_FULL_NEG_MV){
         *pos = - 30;
-    }else if(analog_data < 1000){
+    }else if(analog_data < JOY_NEG_MV){
         *pos = - 10;
-    }else if(analog_data < 2300){
+    }else if(analog_data < JOY_POS_MV){
         *pos = 0;
-    }else if(analog_data < 3250){
+    }else if(analog_data < JOY_FULL_POS_MV){
         *pos = 10;
     }else{
         *pos = 30;
@@ -70,6 +70,7 @@
 TaskHandle_t plot_task_handle = NULL;
 static float fft[CHUNK/2];
 static float chunk[CHUNK];
+static fft_plan_t fft_plan;
 static uint32_t song_index = 0;
 static bool reset = false;
 /*==================[internal functions declaration]=========================*/
@@ -120,7 +121,7 @@ void Song2Bars(const uint8_t* song, uint8_t* bars){
         chunk[i] = song[i] - (MAX_DAC/2);
     }
     /* Calculo de FFT */
-    FFTMagnitude(chunk, fft, CHUNK);
+    FFTPlanMagnitude(&fft_plan, chunk, fft);
     /* Calcular la altura de las barras a partir de los valores de la FFT */
     steps = (CHUNK / 2) / VUM_BARS;
     for(uint8_t i=0; i<VUM_BARS; i++){
@@ -195,6 +196,7 @@ void app_main(void){
     AnalogOutputInit();
     /* FFT */
     FFTInit();
+    FFTPlanInit(&fft_plan, CHUNK, FFT_WINDOW_HANN);
 
     /* Configuración de display */
     ILI9341Init(SPI_1, GPIO_9, GPIO_18);
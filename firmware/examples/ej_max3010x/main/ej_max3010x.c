@@ -36,10 +36,11 @@
 /*==================[macros and definitions]=================================*/
 #define BUFFER_SIZE 256
 #define SAMPLE_FREQ	100
+#define HP_ORDER	ORDER_4		/* orden del filtro pasa altos (IirStepN() con HP_ORDER / 2 secciones) */
 #define CONFIG_BLINK_PERIOD 100
 /*==================[internal data definition]===============================*/
 float dato_filt;
-float dato;
+static iir_filter_t red_hp;     /* filtro pasa altos de la señal roja */
 
 uint32_t irBuffer[100]; //infrared LED sensor data
 uint32_t redBuffer[100];  //red LED sensor data
@@ -53,7 +54,13 @@ int8_t validHeartRate; //indicator to show if the heart rate calculation is vali
 /*==================[external functions definition]==========================*/
 void app_main(void){
     /* Filtro pasa altos de orden 4 con frecuencia de corte en 1Hz */
-	HiPassInit(SAMPLE_FREQ, 1, ORDER_4);
+	iir_filter_config_t hp_config = {
+		.type = IIR_HI_PASS,
+		.sample_frec = SAMPLE_FREQ,
+		.cut_frec = 1,
+		.order = HP_ORDER
+	};
+	IirInit(&red_hp, &hp_config);
     LedsInit();
     MAX3010X_begin();
 	MAX3010X_setup( 30, 1 , 2, SAMPLE_FREQ, 69, 4096);
@@ -79,8 +86,7 @@ void app_main(void){
 		    MAX3010X_nextSample(); //We're finished with this sample so move to next sample
 		            
             //send samples and calculation result to terminal program through UART
-	     	dato = (float)redBuffer[i];
-			HiPassFilter(&dato, &dato_filt, 1);
+			dato_filt = IirStepN(&red_hp, (float)redBuffer[i], HP_ORDER / 2);
 	        //printf("%ld,%2.2f,%ld\n", redBuffer[i], dato_filt, heartRate);
              
 	}
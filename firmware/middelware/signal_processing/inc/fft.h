@@ -16,6 +16,13 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 15/03/2024 | Document creation		                         						|
+ * | 16/10/2026 | Real signals transformed with a half lenght radix-4 complex FFT		|
+ * | 16/10/2026 | FFT plans with cached window, tables and scratch (fft_plan_t)			|
+ * | 16/10/2026 | Fixed point (Q15) FFT plans for targets without FPU					|
+ * | 16/10/2026 | Magnitude of two real signals with one FFT (FFTPlanMagnitudeDual)		|
+ * | 16/10/2026 | Window generation available to other modules (FFTWindow)				|
+ * | 16/10/2026 | Compile time FFT tables, allocation free FFTInit (CONFIG_FFT_CONST_TABLES)|
+ * | 16/10/2026 | Plans use fixed size FFT kernels (fft_static.h) for 256 to 1024 points	|
  * 
  **/
 
@@ -25,6 +32,51 @@
 /*==================[macros]=================================================*/
 #define MAX_SIGNAL_LENGHT   2048
 /*==================[typedef]================================================*/
+/**
+ * @brief Window applied to the signal before the FFT
+ */
+typedef enum fft_window {
+    FFT_WINDOW_NONE,            /*!< Rectangular window */
+    FFT_WINDOW_HANN,            /*!< Hann window */
+    FFT_WINDOW_BLACKMAN,        /*!< Blackman window */
+    FFT_WINDOW_BLACKMAN_HARRIS, /*!< Blackman-Harris window */
+    FFT_WINDOW_NUTTALL,         /*!< Nuttall window */
+    FFT_WINDOW_FLAT_TOP         /*!< Flat-Top window */
+} fft_window_t;
+
+/**
+ * @brief FFT plan for real signals of a given lenght
+ * 
+ * Each plan owns its window, twiddle and bit reverse tables and a scratch buffer,
+ * so different tasks can compute FFTs at the same time using their own plan.
+ */
+typedef struct {
+    uint16_t signal_lenght;     /*!< Number of real samples (power of two) */
+    fft_window_t window_type;   /*!< Window applied before the FFT */
+    float * window;             /*!< Precomputed window (signal_lenght values) */
+    float * twiddle;            /*!< sin/cos table for radix-4 FFT and real split (2 * signal_lenght values) */
+    float * twiddle_r2;         /*!< Bit reversed sin/cos table for radix-2 FFT (signal_lenght / 2 values, NULL if not used) */
+    uint16_t * bit_rev;         /*!< Bit reverse swap table (pairs of byte offsets) */
+    uint16_t bit_rev_size;      /*!< Number of swaps in bit reverse table */
+    uint16_t * bit_rev_dual;    /*!< Bit reverse swap table for signal_lenght complex points (NULL if signal_lenght is not a power of 4) */
+    uint16_t bit_rev_dual_size; /*!< Number of swaps in dual bit reverse table */
+    float * scratch;            /*!< Work buffer (signal_lenght values, 2 * signal_lenght if bit_rev_dual is used) */
+} fft_plan_t;
+
+/**
+ * @brief Fixed point (Q15) FFT plan for real signals of a given lenght
+ * 
+ * Integer only version of fft_plan_t for targets without FPU (e.g. ESP32-C6). The input 
+ * frame is normalized to use the full 16 bits range and the FFT scales by 1/2 on each stage, 
+ * so the spectrum is returned as integers plus a block exponent.
+ */
+typedef struct {
+    uint16_t signal_lenght;     /*!< Number of real samples (power of two) */
+    fft_window_t window_type;   /*!< Window applied before the FFT */
+    int16_t * window;           /*!< Precomputed Q15 window (signal_lenght values) */
+    int16_t * twiddle;          /*!< Bit reversed Q15 sin/cos table (signal_lenght values) */
+    int16_t * scratch;          /*!< Work buffer (signal_lenght values) */
+} fft_plan_q15_t;
 
 /*==================[external data declaration]==============================*/
 
@@ -32,6 +84,8 @@
 /**
  * @brief Initialize the FFT calculation module
  * 
+ * @note  With CONFIG_FFT_CONST_TABLES tables are already stored in flash and nothing is allocated
+ * 
  * @return true     FFT initialized
  * @return false    Not possible to initialize FFT
  */
@@ -48,6 +102,111 @@ bool FFTInit(void);
  */
 void FFTMagnitude(float * signal, float * fft, uint16_t signal_lenght);
 
+/**
+ * @brief Initialize a FFT plan: allocates and computes window, twiddle and bit reverse tables
+ * 
+ * @note  FFTInit() must be called before using any plan
+ * @note  Lenght of signal array must be a power of two (with maximun value = MAX_SIGNAL_LENGHT)
+ * 
+ * @param plan              Pointer to plan to initialize
+ * @param signal_lenght     Lenght of signal arrays to transform
+ * @param window            Window applied before the FFT
+ * @return true             Plan initialized
+ * @return false            Invalid lenght or not enough memory
+ */
+bool FFTPlanInit(fft_plan_t * plan, uint16_t signal_lenght, fft_window_t window);
+
+/**
+ * @brief Release the memory used by a FFT plan
+ * 
+ * @param plan              Pointer to plan
+ */
+void FFTPlanDeinit(fft_plan_t * plan);
+
+/**
+ * @brief Calculates the FFT magnitude of a given signal using a FFT plan
+ * 
+ * Result is the same as FFTMagnitude() with a Hann window, but without recalculating
+ * the window and using the plan's own buffers (reentrant).
+ * 
+ * @param plan              Pointer to initialized plan
+ * @param signal            Array with signal values (of lenght = plan->signal_lenght)
+ * @param fft               Array to store FFT magnitude values (of lenght = plan->signal_lenght / 2)
+ */
+void FFTPlanMagnitude(fft_plan_t * plan, float * signal, float * fft);
+
+/**
+ * @brief Calculates the FFT magnitude of two signals of the same lenght using a FFT plan
+ * 
+ * When plan->signal_lenght is a power of 4, both signals are packed as real and imaginary 
+ * parts of one complex signal, transformed with a single radix-4 FFT and separated using 
+ * conjugate symmetry. Otherwise the two half lenght real FFTs are cheaper, and are used instead.
+ * Results are the same as calling FFTPlanMagnitude() for each signal.
+ * 
+ * @param plan              Pointer to initialized plan
+ * @param signal_a          Array with first signal values (of lenght = plan->signal_lenght)
+ * @param signal_b          Array with second signal values (of lenght = plan->signal_lenght)
+ * @param fft_a             Array to store FFT magnitude of first signal (of lenght = plan->signal_lenght / 2)
+ * @param fft_b             Array to store FFT magnitude of second signal (of lenght = plan->signal_lenght / 2)
+ */
+void FFTPlanMagnitudeDual(fft_plan_t * plan, float * signal_a, float * signal_b, float * fft_a, float * fft_b);
+
+/**
+ * @brief Calculates the FFT power (squared magnitude) of a given signal using a FFT plan
+ * 
+ * @note  Same scaling as FFTPlanMagnitude(), but avoids the square root of each bin
+ * 
+ * @param plan              Pointer to initialized plan
+ * @param signal            Array with signal values (of lenght = plan->signal_lenght)
+ * @param power             Array to store FFT power values (of lenght = plan->signal_lenght / 2)
+ */
+void FFTPlanPower(fft_plan_t * plan, float * signal, float * power);
+
+/**
+ * @brief Initialize a fixed point (Q15) FFT plan
+ * 
+ * @note  Lenght of signal array must be a power of two (with maximun value = MAX_SIGNAL_LENGHT)
+ * 
+ * @param plan              Pointer to plan to initialize
+ * @param signal_lenght     Lenght of signal arrays to transform
+ * @param window            Window applied before the FFT
+ * @return true             Plan initialized
+ * @return false            Invalid lenght or not enough memory
+ */
+bool FFTPlanQ15Init(fft_plan_q15_t * plan, uint16_t signal_lenght, fft_window_t window);
+
+/**
+ * @brief Release the memory used by a fixed point FFT plan
+ * 
+ * @param plan              Pointer to plan
+ */
+void FFTPlanQ15Deinit(fft_plan_q15_t * plan);
+
+/**
+ * @brief Calculates the FFT magnitude of a given signal using only integer operations
+ * 
+ * Magnitude of each bin is approximated as max(hi, 7/8 hi + 1/2 lo) (hi and lo being the 
+ * greater and lower absolute values of real and imaginary parts), with a maximum error of 3%,
+ * plus up to 2 LSB of fft[i] from the rounding of the fixed point transform (relevant on small
+ * bins). The magnitude in the same units as FFTMagnitude() is fft[i] * 2^exponent. Checked
+ * against FFTPlanMagnitude() on the host by test/test_fft.c (make run).
+ * 
+ * @param plan              Pointer to initialized plan
+ * @param signal            Array with signal values (of lenght = plan->signal_lenght)
+ * @param fft               Array to store FFT magnitude values (of lenght = plan->signal_lenght / 2)
+ * @return int8_t           Block exponent of the magnitude values
+ */
+int8_t FFTPlanQ15Magnitude(fft_plan_q15_t * plan, const int16_t * signal, uint16_t * fft);
+
+/**
+ * @brief Fill a window array
+ *
+ * @param window            Array to store window values
+ * @param type              Window type
+ * @param lenght            Window lenght
+ */
+void FFTWindow(float * window, fft_window_t type, uint16_t lenght);
+
 /**
  * @brief Return the FFT frequency axis vector
  * 
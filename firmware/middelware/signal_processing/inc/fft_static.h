@@ -0,0 +1,110 @@
+#ifndef FFT_STATIC_H_
+#define FFT_STATIC_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup FFT_Static Fixed Size FFT
+ */
+
+/** \brief C wrappers of the fixed size FFT kernels (fft_static.hpp)
+ *
+ * Complex FFT in place of interleaved (re, im) data, with results in natural order
+ * (no bit reversal needed). Q15 results are scaled by 1/N.
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 256 points complex FFT
+ *
+ * @param data      Array of 256 complex values (512 floats)
+ */
+void FFTStatic256(float * data);
+
+/**
+ * @brief 512 points complex FFT
+ *
+ * @param data      Array of 512 complex values (1024 floats)
+ */
+void FFTStatic512(float * data);
+
+/**
+ * @brief 1024 points complex FFT
+ *
+ * @param data      Array of 1024 complex values (2048 floats)
+ */
+void FFTStatic1024(float * data);
+
+/**
+ * @brief 256 points complex FFT (Q15, scaled by 1/256)
+ *
+ * @param data      Array of 256 complex values (512 int16_t)
+ */
+void FFTStatic256Q15(int16_t * data);
+
+/**
+ * @brief 512 points complex FFT (Q15, scaled by 1/512)
+ *
+ * @param data      Array of 512 complex values (1024 int16_t)
+ */
+void FFTStatic512Q15(int16_t * data);
+
+/**
+ * @brief 1024 points complex FFT (Q15, scaled by 1/1024)
+ *
+ * @param data      Array of 1024 complex values (2048 int16_t)
+ */
+void FFTStatic1024Q15(int16_t * data);
+
+/**
+ * @brief Complex FFT with the fixed size kernel of n_cplx points (if available)
+ *
+ * @param data      Array of n_cplx complex values
+ * @param n_cplx    Number of complex points
+ * @return true     FFT calculated
+ * @return false    No fixed size kernel for n_cplx points (data is not modified)
+ */
+bool FFTStaticTransform(float * data, uint16_t n_cplx);
+
+/**
+ * @brief Q15 complex FFT with the fixed size kernel of n_cplx points (if available)
+ *
+ * @param data      Array of n_cplx complex values
+ * @param n_cplx    Number of complex points
+ * @return true     FFT calculated (scaled by 1/n_cplx)
+ * @return false    No fixed size kernel for n_cplx points (data is not modified)
+ */
+bool FFTStaticTransformQ15(int16_t * data, uint16_t n_cplx);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* FFT_STATIC_H_ */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,290 @@
+#ifndef FFT_STATIC_HPP_
+#define FFT_STATIC_HPP_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup FFT_Static Fixed Size FFT
+ */
+
+/** \brief Header only C++ FFT specialised at compile time for each lenght
+ *
+ * fft<N, T>::Transform() calculates the N points complex FFT of interleaved (re, im)
+ * data in place, with results in natural order. Lenght, strides and twiddle indices of
+ * every stage are compile time constants, and twiddle and bit reverse tables are
+ * calculated by the compiler and stored in flash, so small stages are fully unrolled
+ * and the first two stages need no multiplications.
+ *
+ * T can be float, int16_t (Q15) or int32_t (Q31). Fixed point results are scaled by 1/N
+ * (each stage is halved, as dsps_fft2r_sc16()). Butterflies keep the products at full
+ * precision and round once per output, so errors don't build up a bias over the stages.
+ *
+ * C code uses the wrappers declared in fft_static.h.
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+namespace fft_static {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr int kSeriesTerms = 30;            /*!< Enough for double precision in [-pi, pi] */
+
+/**
+ * @brief Angle 2*pi*i/n reduced to [-pi, pi]
+ */
+constexpr double Angle(int i, int n){
+    double angle = 2 * kPi * i / n;
+    if (angle > kPi){
+        angle -= 2 * kPi;
+    }
+    return angle;
+}
+
+/**
+ * @brief sin(x) by Taylor series (x in [-pi, pi])
+ */
+constexpr double Sin(double x){
+    double term = x;
+    double sum = x;
+    for (int k = 1; k < kSeriesTerms; k++){
+        term *= -x * x / ((2 * k) * (2 * k + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+/**
+ * @brief cos(x) by Taylor series (x in [-pi, pi])
+ */
+constexpr double Cos(double x){
+    double term = 1;
+    double sum = 1;
+    for (int k = 1; k < kSeriesTerms; k++){
+        term *= -x * x / ((2 * k - 1) * (2 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr int Log2(int n){
+    int bits = 0;
+    while ((1 << bits) < n){
+        bits++;
+    }
+    return bits;
+}
+
+constexpr int BitReverse(int i, int bits){
+    int rev = 0;
+    for (int b = 0; b < bits; b++){
+        rev = (rev << 1) | ((i >> b) & 0x01);
+    }
+    return rev;
+}
+
+/**
+ * @brief Number of swaps of the bit reverse permutation of n points
+ */
+constexpr int BitReverseSwaps(int n){
+    int count = 0;
+    for (int i = 0; i < n; i++){
+        if (i < BitReverse(i, Log2(n))){
+            count++;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Arithmetic of each data type
+ */
+template <typename T>
+struct traits;
+
+template <>
+struct traits<float> {
+    typedef float acc_t;                    /*!< Type of intermediate results */
+    static constexpr float Twiddle(double value){ return value; }
+    static inline acc_t Wide(acc_t a){ return a; }                  /*!< Value to product scale */
+    static inline acc_t Mul(acc_t a, acc_t w){ return a * w; }      /*!< Product (not rounded) */
+    static inline float Scale(acc_t a){ return a; }                 /*!< Product scale to value, halved (rounded) */
+    static inline float Scale2(acc_t a){ return a; }                /*!< Value quartered (rounded) */
+};
+
+template <>
+struct traits<int16_t> {
+    typedef int32_t acc_t;
+    static constexpr int16_t Twiddle(double value){ return (int16_t)(value * 32767 + (value < 0 ? -0.5 : 0.5)); }
+    // Q30 sums of at most 2.5 * 2^30: no overflow
+    static inline acc_t Wide(acc_t a){ return a * 32767; }
+    static inline acc_t Mul(acc_t a, acc_t w){ return a * w; }
+    static inline int16_t Scale(acc_t a){ return (a + 0x7FFF) >> 16; }
+    static inline int16_t Scale2(acc_t a){ return (a + 2) >> 2; }
+};
+
+template <>
+struct traits<int32_t> {
+    typedef int64_t acc_t;
+    static constexpr int32_t Twiddle(double value){ return (int32_t)(value * 2147483647.0 + (value < 0 ? -0.5 : 0.5)); }
+    // Q61 products: sums of at most 1.25 * 2^62, no overflow
+    static inline acc_t Wide(acc_t a){ return a * 1073741824; }
+    static inline acc_t Mul(acc_t a, acc_t w){ return (a * w) >> 1; }
+    static inline int32_t Scale(acc_t a){ return (a + 0x3FFFFFFF) >> 31; }
+    static inline int32_t Scale2(acc_t a){ return (a + 2) >> 2; }
+};
+
+/**
+ * @brief Twiddle table: cos/sin(2*pi*k/N) for k < N/2
+ */
+template <int N, typename T>
+struct twiddle_table {
+    T w[N];
+    constexpr twiddle_table() : w(){
+        for (int k = 0; k < N / 2; k++){
+            w[2 * k + 0] = traits<T>::Twiddle(Cos(Angle(k, N)));
+            w[2 * k + 1] = traits<T>::Twiddle(Sin(Angle(k, N)));
+        }
+    }
+};
+
+/**
+ * @brief Bit reverse table: pairs of complex indexes to swap
+ */
+template <int N>
+struct bit_rev_table {
+    static constexpr int swaps = BitReverseSwaps(N);
+    uint16_t pairs[2 * swaps];
+    constexpr bit_rev_table() : pairs(){
+        int count = 0;
+        for (int i = 0; i < N; i++){
+            int rev = BitReverse(i, Log2(N));
+            if (i < rev){
+                pairs[2 * count + 0] = i;
+                pairs[2 * count + 1] = rev;
+                count++;
+            }
+        }
+    }
+};
+
+/**
+ * @brief N points complex FFT
+ *
+ * @tparam N    Number of complex points (power of two, >= 4)
+ * @tparam T    float, int16_t (Q15) or int32_t (Q31)
+ */
+template <int N, typename T = float>
+class fft {
+    static_assert((N >= 4) && ((N & (N - 1)) == 0), "FFT lenght must be a power of two >= 4");
+public:
+    static constexpr int size = N;
+
+    /**
+     * @brief Calculate the FFT in place
+     *
+     * @param data  Array of N complex values (re, im), result in natural order
+     */
+    static void Transform(T * data){
+        BitReversal(data);
+        Stages<4>(data);
+    }
+
+private:
+    typedef typename traits<T>::acc_t acc_t;
+    static constexpr twiddle_table<N, T> twiddle{};
+    static constexpr bit_rev_table<N> bit_rev{};
+
+    static inline void BitReversal(T * data){
+        for (int k = 0; k < bit_rev_table<N>::swaps; k++){
+            int i = 2 * bit_rev.pairs[2 * k + 0];
+            int j = 2 * bit_rev.pairs[2 * k + 1];
+            T re = data[i];
+            T im = data[i + 1];
+            data[i] = data[j];
+            data[i + 1] = data[j + 1];
+            data[j] = re;
+            data[j + 1] = im;
+        }
+    }
+
+    /**
+     * @brief Butterfly with twiddle (c, s): b * (c - js)
+     */
+    static inline void Butterfly(T * a, T * b, acc_t c, acc_t s){
+        acc_t t_re = traits<T>::Mul(b[0], c) + traits<T>::Mul(b[1], s);
+        acc_t t_im = traits<T>::Mul(b[1], c) - traits<T>::Mul(b[0], s);
+        acc_t a_re = traits<T>::Wide(a[0]);
+        acc_t a_im = traits<T>::Wide(a[1]);
+        a[0] = traits<T>::Scale(a_re + t_re);
+        a[1] = traits<T>::Scale(a_im + t_im);
+        b[0] = traits<T>::Scale(a_re - t_re);
+        b[1] = traits<T>::Scale(a_im - t_im);
+    }
+
+    /**
+     * @brief Stages of lenght 2 and 4 merged (twiddles 1 and -j, no multiplications)
+     */
+    template <int Len>
+    static inline void Stages(T * data){
+        if constexpr (Len == 4){
+            for (int i = 0; i < 2 * N; i += 8){
+                acc_t x0_re = data[i + 0], x0_im = data[i + 1];
+                acc_t x1_re = data[i + 2], x1_im = data[i + 3];
+                acc_t x2_re = data[i + 4], x2_im = data[i + 5];
+                acc_t x3_re = data[i + 6], x3_im = data[i + 7];
+                // Stage of lenght 2 (exact, halving of both stages rounded once)
+                acc_t a0_re = x0_re + x1_re, a0_im = x0_im + x1_im;
+                acc_t a1_re = x0_re - x1_re, a1_im = x0_im - x1_im;
+                acc_t a2_re = x2_re + x3_re, a2_im = x2_im + x3_im;
+                acc_t a3_re = x2_re - x3_re, a3_im = x2_im - x3_im;
+                // Stage of lenght 4: a3 * (-j) = (a3_im, -a3_re)
+                data[i + 0] = traits<T>::Scale2(a0_re + a2_re);
+                data[i + 1] = traits<T>::Scale2(a0_im + a2_im);
+                data[i + 4] = traits<T>::Scale2(a0_re - a2_re);
+                data[i + 5] = traits<T>::Scale2(a0_im - a2_im);
+                data[i + 2] = traits<T>::Scale2(a1_re + a3_im);
+                data[i + 3] = traits<T>::Scale2(a1_im - a3_re);
+                data[i + 6] = traits<T>::Scale2(a1_re - a3_im);
+                data[i + 7] = traits<T>::Scale2(a1_im + a3_re);
+            }
+        }
+        else{
+            constexpr int half = Len / 2;
+            constexpr int stride = N / Len;
+            for (int block = 0; block < N; block += Len){
+                T * a = &data[2 * block];
+                T * b = &data[2 * (block + half)];
+                for (int j = 0; j < half; j++){
+                    Butterfly(&a[2 * j], &b[2 * j], twiddle.w[2 * j * stride], twiddle.w[2 * j * stride + 1]);
+                }
+            }
+        }
+        if constexpr (Len < N){
+            Stages<2 * Len>(data);
+        }
+    }
+};
+
+} // namespace fft_static
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* FFT_STATIC_HPP_ */
+
+/*==================[end of file]============================================*/
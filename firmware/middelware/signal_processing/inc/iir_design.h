@@ -0,0 +1,84 @@
+#ifndef IIR_DESIGN_H_
+#define IIR_DESIGN_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup IIR_Design IIR Design
+ */
+
+/** \brief IIR filter designer (Butterworth, Chebyshev I/II and Bessel of any order)
+ *
+ * Low pass, hi pass, band pass and band stop filters are designed from the analog
+ * prototype (poles and zeros), transformed with the bilinear transform (pre-warped edges)
+ * and factored into second order sections ready for IirFilter().
+ *
+ * Poles are paired with their nearest zeros, sections are ordered from the farthest to
+ * the closest poles to the unit circle (highest Q last), and each section has unity gain
+ * at the pass band reference frequency (DC, Nyquist or band center).
+ *
+ * A design only depends on its configuration and is stored in filter->n_sos and
+ * filter->coeff: they can be saved (const table, NVS blob) and restored with IirLoad()
+ * to avoid designing the filter at every boot.
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "iir_filter.h"
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+/**
+ * @brief Filter family
+ */
+typedef enum iir_design_family {
+    IIR_BUTTERWORTH,        /*!< Maximally flat pass band (-3 dB at cut-off) */
+    IIR_CHEBYSHEV_1,        /*!< Ripple in pass band (-ripple dB at cut-off) */
+    IIR_CHEBYSHEV_2,        /*!< Ripple in stop band (-ripple dB from cut-off on) */
+    IIR_BESSEL              /*!< Maximally flat group delay (-3 dB at cut-off) */
+} iir_design_family_t;
+
+/**
+ * @brief IIR design config structure
+ */
+typedef struct {
+    iir_design_family_t family; /*!< Filter family */
+    iir_filter_type_t type;     /*!< Low pass, hi pass, band pass or band stop */
+    float sample_frec;          /*!< Signal's sample frequency */
+    float cut_frec;             /*!< Cut-off frequency (low and hi pass) or lower edge (band pass and band stop) */
+    float cut_frec_high;        /*!< Upper edge (band pass and band stop) */
+    uint8_t order;              /*!< Prototype order: up to 2 * IIR_MAX_SOS (low and hi pass) or IIR_MAX_SOS (band pass and band stop, filter order is 2 * order) */
+    float ripple;               /*!< Pass band ripple (Chebyshev I) or stop band attenuation (Chebyshev II) in dB */
+} iir_design_config_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Design a filter and initialize a filter instance with it
+ *
+ * @note Uses double precision complex arithmetic: intended for initialization, not
+ * for the signal processing loop.
+ *
+ * @param filter        Pointer to filter instance
+ * @param config        Pointer to design configuration
+ * @return true         Filter designed
+ * @return false        Invalid configuration
+ */
+bool IirDesign(iir_filter_t * filter, iir_design_config_t * config);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* IIR_DESIGN_H_ */
+
+/*==================[end of file]============================================*/
@@ -16,12 +16,24 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 15/03/2024 | Document creation		                         						|
+ * | 16/10/2026 | Filter instances (iir_filter_t) with own coefficients and delay lines	|
+ * | 16/10/2026 | Each sample filtered through all sections in one pass (IirFilterChain)	|
+ * | 16/10/2026 | Band pass / band stop types and IirLoad() (see iir_design.h)			|
+ * | 16/10/2026 | Multi-channel filters (iir_multi_t), interleaved or one array each	|
+ * | 16/10/2026 | Zero-phase forward-backward filtering (IirFiltFilt)					|
+ * | 16/10/2026 | Inline per sample filtering (IirStep, IirStepN)						|
+ * | 16/10/2026 | Coefficient hot-swap of running filters (iir_swap_t)					|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include <stdint.h>
+#include <stdbool.h>
 /*==================[macros]=================================================*/
+#define IIR_MAX_SOS     8       /*!< Maximum number of second order sections of a filter */
+#define IIR_SOS_COEFF   5       /*!< Coefficients of each section (b0, b1, b2, a1, a2) */
+#define IIR_SOS_DELAY   2       /*!< Delay values of each section */
+#define IIR_MAX_CHANNELS 4      /*!< Maximum number of channels of a multi-channel filter */
 
 /*==================[typedef]================================================*/
 typedef enum filter_order {
@@ -30,12 +42,88 @@ typedef enum filter_order {
     ORDER_6 = 6,        /*!< 6th order filter */
     ORDER_8 = 8         /*!< 8th order filter */
 } filter_order_t;
+
+/**
+ * @brief Filter type
+ */
+typedef enum iir_filter_type {
+    IIR_LOW_PASS,       /*!< Low pass filter */
+    IIR_HI_PASS,        /*!< Hi pass filter */
+    IIR_BAND_PASS,      /*!< Band pass filter (IirDesign() only) */
+    IIR_BAND_STOP       /*!< Band stop filter (IirDesign() only) */
+} iir_filter_type_t;
+
+/**
+ * @brief IIR filter config structure
+ */
+typedef struct {
+    iir_filter_type_t type;     /*!< Filter type */
+    float sample_frec;          /*!< Signal's sample frequency */
+    float cut_frec;             /*!< Filter's cut-off frequency */
+    filter_order_t order;       /*!< Filter's order (2, 4, 6 or 8) */
+} iir_filter_config_t;
+
+/**
+ * @brief IIR filter instance (cascade of second order sections)
+ * 
+ * Each instance owns its coefficients and delay lines, so any number of signals can be
+ * filtered independently (one instance per signal).
+ */
+typedef struct {
+    uint8_t n_sos;                                  /*!< Number of second order sections */
+    float coeff[IIR_MAX_SOS * IIR_SOS_COEFF];       /*!< Coefficients of each section (b0, b1, b2, a1, a2) */
+    float delay[IIR_MAX_SOS * IIR_SOS_DELAY];       /*!< Delay line of each section */
+} iir_filter_t;
+
+/**
+ * @brief Multi-channel IIR filter (same number of sections on every channel)
+ * 
+ * All channels are filtered in the same loop, so the independent recurrences of each
+ * channel are interleaved. Coefficients can be shared by all channels or own by each one.
+ */
+typedef struct {
+    uint8_t n_channels;                                                 /*!< Number of channels */
+    uint8_t n_sos;                                                      /*!< Number of second order sections */
+    bool shared;                                                        /*!< All channels use the coefficients of channel 0 */
+    float coeff[IIR_MAX_CHANNELS * IIR_MAX_SOS * IIR_SOS_COEFF];        /*!< Coefficients of each section of each channel */
+    float delay[IIR_MAX_CHANNELS * IIR_MAX_SOS * IIR_SOS_DELAY];        /*!< Delay line of each section of each channel */
+} iir_multi_t;
+
+/**
+ * @brief Filter state after a coefficient swap
+ */
+typedef enum iir_swap_mode {
+    IIR_SWAP_KEEP_STATE,        /*!< Delay lines of the previous filter are kept (small changes) */
+    IIR_SWAP_STEADY_STATE,      /*!< Delay lines set to the steady state of the last input sample */
+    IIR_SWAP_CROSSFADE          /*!< Steady state, and output faded from previous to new filter */
+} iir_swap_mode_t;
+
+/**
+ * @brief Filter with double-buffered coefficients, that can be replaced while it is running
+ * 
+ * New coefficients are written to the standby filter by IirSwapLoad() (e.g. from a BLE
+ * callback) and the filtering task switches to them at the start of its next block in
+ * IirSwapFilter(). The active filter is never written while it's in use. Lock-free for
+ * one task loading and one task filtering.
+ */
+typedef struct {
+    iir_filter_t bank[2];       /*!< Active and standby filters */
+    uint32_t swap_state;        /*!< Index of the active filter (bit 0) and standby filter state (loaded, in use by a cross-fade) */
+    iir_swap_mode_t mode;       /*!< Filter state after a swap */
+    uint16_t fade_lenght;       /*!< Samples of the cross-fade (IIR_SWAP_CROSSFADE) */
+    uint16_t fade_pos;          /*!< Samples of the current cross-fade already filtered */
+    float last_sample;          /*!< Last input sample (steady state after a swap) */
+} iir_swap_t;
 /*==================[external data declaration]==============================*/
 
 /*==================[external functions declaration]=========================*/
 /**
  * @brief Initialize a 2nd order Butterwotrh Low Pass Filter
  * 
+ * Can be called again to change the filter while LowPassFilter() is running in another task:
+ * new coefficients are used from its next block, starting from the steady state of the
+ * last input sample.
+ * 
  * @param sample_frec   Signal's sample frequency
  * @param cut_frec      Filter's cut-off frequency
  * @param order         Filter's order (2, 4, 6 or 8)
@@ -45,6 +133,10 @@ void LowPassInit(float sample_frec, float cut_frec, filter_order_t order);
 /**
  * @brief Initialize a 2nd order Butterwotrh Hi Pass Filter
  * 
+ * Can be called again to change the filter while HiPassFilter() is running in another task:
+ * new coefficients are used from its next block, starting from the steady state of the
+ * last input sample.
+ * 
  * @param sample_frec   Signal's sample frequency
  * @param cut_frec      Filter's cut-off frequency
  * @param order         Filter's order (2, 4, 6 or 8)
@@ -69,6 +161,208 @@ void LowPassFilter(float * input_signal, float * output_signal, int16_t signal_l
  */
 void HiPassFilter(float * input_signal, float * output_signal, int16_t signal_lenght);
 
+/**
+ * @brief Initialize a Butterworth filter instance
+ * 
+ * @param filter        Pointer to filter instance
+ * @param config        Pointer to filter configuration
+ * @return true         Filter initialized
+ * @return false        Invalid configuration
+ */
+bool IirInit(iir_filter_t * filter, iir_filter_config_t * config);
+
+/**
+ * @brief Initialize a filter instance from precalculated coefficients (e.g. a design
+ * stored in flash or NVS)
+ * 
+ * @param filter        Pointer to filter instance
+ * @param coeff         Coefficients of each section (b0, b1, b2, a1, a2)
+ * @param n_sos         Number of sections (1 to IIR_MAX_SOS)
+ * @return true         Filter initialized
+ * @return false        Invalid number of sections
+ */
+bool IirLoad(iir_filter_t * filter, const float * coeff, uint8_t n_sos);
+
+/**
+ * @brief Apply a filter to a signal array (filter state is kept between calls)
+ * 
+ * Each sample goes through all sections before the next one is read (the signal is
+ * read and written once for filters up to 8th order).
+ * 
+ * @param filter            Pointer to filter instance
+ * @param input_signal      Input signal array
+ * @param output_signal     Filtered signal array (can be the same as input_signal)
+ * @param signal_lenght     Number of samples of both signals
+ */
+void IirFilter(iir_filter_t * filter, float * input_signal, float * output_signal, int16_t signal_lenght);
+
+/**
+ * @brief Apply two filters one after the other (e.g. hi pass and low pass) in one pass
+ * 
+ * Same result as IirFilter(first, ...) followed by IirFilter(second, ...), but each sample
+ * goes through the sections of both filters before the next one is read (one pass over the
+ * signal every 4 sections).
+ * 
+ * @note Bit identity with dsps_biquad_f32() per section and throughput are checked on the host
+ * by test/test_iir_filter.c (make run)
+ * 
+ * @param first             Pointer to first filter instance
+ * @param second            Pointer to second filter instance
+ * @param input_signal      Input signal array
+ * @param output_signal     Filtered signal array (can be the same as input_signal)
+ * @param signal_lenght     Number of samples of both signals
+ */
+void IirFilterChain(iir_filter_t * first, iir_filter_t * second, float * input_signal, float * output_signal, int16_t signal_lenght);
+
+/**
+ * @brief Clear the delay lines of a filter
+ * 
+ * @param filter        Pointer to filter instance
+ */
+void IirReset(iir_filter_t * filter);
+
+/**
+ * @brief Apply a filter forwards and backwards to a signal window in place (zero phase,
+ * squared magnitude response), as scipy.signal.sosfiltfilt()
+ * 
+ * The window is extended at both ends by odd reflection (3 * (2 * n_sos + 1) samples,
+ * less for shorter windows) and each pass starts from the filter's steady state for
+ * the first extended sample, so there are no start-up transients at the window edges.
+ * Uses no heap; the filter's delay lines are neither used nor modified.
+ * 
+ * @param filter            Pointer to filter instance
+ * @param signal            Signal array, replaced by the filtered signal
+ * @param signal_lenght     Number of samples (at least 2)
+ */
+void IirFiltFilt(iir_filter_t * filter, float * signal, int16_t signal_lenght);
+
+/**
+ * @brief Initialize a multi-channel filter from filter instances (IirInit(), IirDesign() or IirLoad())
+ * 
+ * Filters with less sections than the others are completed with pass-through sections.
+ * 
+ * @param multi         Pointer to multi-channel filter
+ * @param filters       Array of n_filters filter instances (only coefficients are used)
+ * @param n_filters     1 (coefficients shared by all channels) or n_channels (one filter per channel)
+ * @param n_channels    Number of channels (1 to IIR_MAX_CHANNELS)
+ * @return true         Filter initialized
+ * @return false        Invalid number of channels or filters
+ */
+bool IirMultiInit(iir_multi_t * multi, const iir_filter_t * filters, uint8_t n_filters, uint8_t n_channels);
+
+/**
+ * @brief Apply a multi-channel filter to interleaved signals (ch0, ch1, ..., ch0, ch1, ...)
+ * 
+ * @param multi             Pointer to multi-channel filter
+ * @param input_signal      Input array of signal_lenght * n_channels samples
+ * @param output_signal     Filtered array (can be the same as input_signal)
+ * @param signal_lenght     Number of samples of each channel
+ */
+void IirMultiFilter(iir_multi_t * multi, float * input_signal, float * output_signal, int16_t signal_lenght);
+
+/**
+ * @brief Apply a multi-channel filter to signals stored in one array per channel
+ * 
+ * @param multi             Pointer to multi-channel filter
+ * @param input_signals     Array of n_channels input signal arrays
+ * @param output_signals    Array of n_channels filtered signal arrays (can be the same as input_signals)
+ * @param signal_lenght     Number of samples of each channel
+ */
+void IirMultiFilterSoA(iir_multi_t * multi, float ** input_signals, float ** output_signals, int16_t signal_lenght);
+
+/**
+ * @brief Clear the delay lines of all channels of a multi-channel filter
+ * 
+ * @param multi         Pointer to multi-channel filter
+ */
+void IirMultiReset(iir_multi_t * multi);
+
+/**
+ * @brief Initialize a hot-swappable filter
+ * 
+ * @param swap          Pointer to hot-swappable filter
+ * @param filter        Pointer to initial filter (IirInit(), IirDesign() or IirLoad())
+ * @param mode          Filter state after each swap
+ * @param fade_lenght   Samples of each cross-fade (IIR_SWAP_CROSSFADE only)
+ */
+void IirSwapInit(iir_swap_t * swap, const iir_filter_t * filter, iir_swap_mode_t mode, uint16_t fade_lenght);
+
+/**
+ * @brief Load new coefficients, used from the next block filtered by IirSwapFilter()
+ * 
+ * Coefficients loaded and not used yet are replaced. Can be called from a different task
+ * than IirSwapFilter() (only one task loading).
+ * 
+ * @param swap          Pointer to hot-swappable filter
+ * @param filter        Pointer to new filter (only coefficients are used)
+ * @return true         Coefficients loaded
+ * @return false        A cross-fade is in progress (retry later)
+ */
+bool IirSwapLoad(iir_swap_t * swap, const iir_filter_t * filter);
+
+/**
+ * @brief Apply a hot-swappable filter to a signal array, switching first to the last loaded
+ * coefficients (filter state is kept between calls)
+ * 
+ * @param swap              Pointer to hot-swappable filter
+ * @param input_signal      Input signal array
+ * @param output_signal     Filtered signal array (can be the same as input_signal)
+ * @param signal_lenght     Number of samples of both signals
+ */
+void IirSwapFilter(iir_swap_t * swap, float * input_signal, float * output_signal, int16_t signal_lenght);
+
+/*==================[inline functions definition]===========================*/
+/**
+ * @brief Filter one sample through the first n_sos sections of a filter
+ * 
+ * Inlined in the caller: when n_sos is a constant (e.g. ORDER_4 / 2) the loop over
+ * sections is unrolled, so filtering a sample costs only its arithmetic. Same result
+ * as IirFilter() with one sample.
+ * 
+ * @param filter        Pointer to filter instance
+ * @param sample        Input sample
+ * @param n_sos         Number of sections of the filter
+ * @return float        Filtered sample
+ */
+static inline __attribute__((always_inline)) float IirStepN(iir_filter_t * filter, float sample, const uint8_t n_sos){
+    #pragma GCC unroll 8
+    for(uint8_t i=0; i<n_sos; i++){
+        const float * c = &filter->coeff[i * IIR_SOS_COEFF];
+        float * w = &filter->delay[i * IIR_SOS_DELAY];
+        // Same operations as dsps_biquad_f32_ansi()
+        float d0 = sample - c[3] * w[0] - c[4] * w[1];
+        sample = c[0] * d0 + c[1] * w[0] + c[2] * w[1];
+        w[1] = w[0];
+        w[0] = d0;
+    }
+    return sample;
+}
+
+/**
+ * @brief Filter one sample (filter state is kept between calls)
+ * 
+ * Inlined in the caller, with an unrolled version for each number of sections up to
+ * 4 (8th order).
+ * 
+ * @param filter        Pointer to filter instance
+ * @param sample        Input sample
+ * @return float        Filtered sample
+ */
+static inline float IirStep(iir_filter_t * filter, float sample){
+    switch(filter->n_sos){
+        case 1:
+            return IirStepN(filter, sample, 1);
+        case 2:
+            return IirStepN(filter, sample, 2);
+        case 3:
+            return IirStepN(filter, sample, 3);
+        case 4:
+            return IirStepN(filter, sample, 4);
+        default:
+            return IirStepN(filter, sample, filter->n_sos);
+    }
+}
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
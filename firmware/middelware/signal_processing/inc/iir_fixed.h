@@ -0,0 +1,162 @@
+#ifndef IIR_FIXED_H_
+#define IIR_FIXED_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup IIR_Fixed IIR Fixed Point
+ */
+
+/** \brief Fixed point IIR filters (integer arithmetic only, for MCUs without FPU)
+ *
+ * Cascades of direct form I sections quantized from float filters (IirInit(),
+ * IirDesign() or IirLoad()):
+ * - Q15: int16_t samples and coefficients, int32_t (Q31) accumulators.
+ * - Q31: int32_t samples and coefficients, int64_t accumulators. For low cut-off
+ *   frequencies (e.g. 1 Hz hi pass), where Q15 coefficients move the poles and Q15
+ *   states add too much noise.
+ *
+ * Coefficients of each section are scaled by a power of two so that the sum of their
+ * absolute values fits the coefficient type: accumulators can't overflow, and outputs
+ * of each section saturate to the sample type.
+ *
+ * Quantization noise of each section can be shaped by error feedback (first or second
+ * order zeros at DC), which reduces the low frequency noise amplified by poles close to
+ * z = 1 (low cut-off frequencies).
+ *
+ * IirQ15Step() / IirQ31Step() filter one sample and are placed in IRAM, to be called
+ * from the sampling ISR.
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "iir_filter.h"
+/*==================[macros]=================================================*/
+#define IIR_DF1_STATE   4       /*!< State values of each section (x[n-1], x[n-2], y[n-1], y[n-2]) */
+
+/*==================[typedef]================================================*/
+/**
+ * @brief Quantization of section outputs
+ */
+typedef enum iir_shaping {
+    IIR_ROUND,                  /*!< Round to nearest */
+    IIR_SHAPING_1,              /*!< First order error feedback (noise zero at DC) */
+    IIR_SHAPING_2               /*!< Second order error feedback (double noise zero at DC) */
+} iir_shaping_t;
+
+/**
+ * @brief Q15 IIR filter instance
+ */
+typedef struct {
+    uint8_t n_sos;                                  /*!< Number of second order sections */
+    iir_shaping_t shaping;                          /*!< Quantization of section outputs */
+    uint8_t frac_bits[IIR_MAX_SOS];                 /*!< Fractional bits of the coefficients of each section */
+    int16_t coeff[IIR_MAX_SOS * IIR_SOS_COEFF];     /*!< Coefficients of each section (b0, b1, b2, a1, a2) */
+    int16_t state[IIR_MAX_SOS * IIR_DF1_STATE];     /*!< State of each section */
+    int32_t error[IIR_MAX_SOS * 2];                 /*!< Last quantization errors of each section */
+} iir_q15_t;
+
+/**
+ * @brief Q31 IIR filter instance
+ */
+typedef struct {
+    uint8_t n_sos;                                  /*!< Number of second order sections */
+    iir_shaping_t shaping;                          /*!< Quantization of section outputs */
+    uint8_t frac_bits[IIR_MAX_SOS];                 /*!< Fractional bits of the coefficients of each section */
+    int32_t coeff[IIR_MAX_SOS * IIR_SOS_COEFF];     /*!< Coefficients of each section (b0, b1, b2, a1, a2) */
+    int32_t state[IIR_MAX_SOS * IIR_DF1_STATE];     /*!< State of each section */
+    int64_t error[IIR_MAX_SOS * 2];                 /*!< Last quantization errors of each section */
+} iir_q31_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize a Q15 filter quantizing the coefficients of a float filter
+ *
+ * @param q15           Pointer to Q15 filter instance
+ * @param filter        Pointer to initialized float filter (only coefficients are used)
+ * @param shaping       Quantization of section outputs
+ * @return true         Filter initialized
+ * @return false        Coefficients can't be represented
+ */
+bool IirQ15Init(iir_q15_t * q15, const iir_filter_t * filter, iir_shaping_t shaping);
+
+/**
+ * @brief Apply a Q15 filter to a signal array (filter state is kept between calls)
+ *
+ * @param q15               Pointer to Q15 filter instance
+ * @param input_signal      Input signal array
+ * @param output_signal     Filtered signal array (can be the same as input_signal)
+ * @param signal_lenght     Number of samples of both signals
+ */
+void IirQ15Filter(iir_q15_t * q15, const int16_t * input_signal, int16_t * output_signal, int16_t signal_lenght);
+
+/**
+ * @brief Filter one sample with a Q15 filter (IRAM, can be called from an ISR)
+ *
+ * @param q15           Pointer to Q15 filter instance
+ * @param sample        Input sample
+ * @return int16_t      Filtered sample
+ */
+int16_t IirQ15Step(iir_q15_t * q15, int16_t sample);
+
+/**
+ * @brief Clear the state of a Q15 filter
+ *
+ * @param q15           Pointer to Q15 filter instance
+ */
+void IirQ15Reset(iir_q15_t * q15);
+
+/**
+ * @brief Initialize a Q31 filter quantizing the coefficients of a float filter
+ *
+ * @param q31           Pointer to Q31 filter instance
+ * @param filter        Pointer to initialized float filter (only coefficients are used)
+ * @param shaping       Quantization of section outputs
+ * @return true         Filter initialized
+ * @return false        Coefficients can't be represented
+ */
+bool IirQ31Init(iir_q31_t * q31, const iir_filter_t * filter, iir_shaping_t shaping);
+
+/**
+ * @brief Apply a Q31 filter to a signal array (filter state is kept between calls)
+ *
+ * @param q31               Pointer to Q31 filter instance
+ * @param input_signal      Input signal array
+ * @param output_signal     Filtered signal array (can be the same as input_signal)
+ * @param signal_lenght     Number of samples of both signals
+ */
+void IirQ31Filter(iir_q31_t * q31, const int32_t * input_signal, int32_t * output_signal, int16_t signal_lenght);
+
+/**
+ * @brief Filter one sample with a Q31 filter (IRAM, can be called from an ISR)
+ *
+ * @param q31           Pointer to Q31 filter instance
+ * @param sample        Input sample
+ * @return int32_t      Filtered sample
+ */
+int32_t IirQ31Step(iir_q31_t * q31, int32_t sample);
+
+/**
+ * @brief Clear the state of a Q31 filter
+ *
+ * @param q31           Pointer to Q31 filter instance
+ */
+void IirQ31Reset(iir_q31_t * q31);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* IIR_FIXED_H_ */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,166 @@
+#ifndef POWERLINE_H_
+#define POWERLINE_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup Powerline Power Line Canceller
+ */
+
+/** \brief Adaptive cancellation of power line interference (50/60 Hz and harmonics)
+ *
+ * The interference is estimated as a sum of sines at the line frequency and its
+ * harmonics, each with amplitude and phase adapted by LMS (two weights per harmonic, sine
+ * and cosine references), and subtracted from the signal. Each harmonic behaves as a
+ * notch of the configured bandwidth that follows the amplitude and phase of the
+ * interference, so the rest of the signal band is not affected.
+ *
+ * Line frequency drift is tracked from the rotation of the fundamental's weights, every
+ * POWERLINE_TRACK_PERIOD samples, within +-max_deviation of the nominal frequency. Signal
+ * components inside that range are taken as interference, so keep it as narrow as the
+ * line allows (e.g. 0.5 Hz).
+ *
+ * Cost per sample is fixed: one complex multiplication and two weight updates per harmonic.
+ * The Q15 variant (powerline_q15_t) uses integer arithmetic only (phase accumulator and
+ * interpolated sine table).
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+#define POWERLINE_MAX_HARMONICS 5       /*!< Maximum number of cancelled harmonics (fundamental included) */
+#define POWERLINE_TRACK_PERIOD  32      /*!< Samples between line frequency updates */
+
+/*==================[typedef]================================================*/
+/**
+ * @brief Power line canceller config structure
+ */
+typedef struct {
+    float sample_freq;          /*!< Signal's sample frequency */
+    float line_freq;            /*!< Nominal line frequency (50 or 60 Hz) */
+    uint8_t harmonics;          /*!< Cancelled harmonics, fundamental included (1 to POWERLINE_MAX_HARMONICS, below sample_freq / 2) */
+    float bandwidth;            /*!< Bandwidth of each notch (Hz): wider adapts faster */
+    float max_deviation;        /*!< Maximum tracked deviation from line_freq (Hz, 0: no tracking) */
+} powerline_config_t;
+
+/**
+ * @brief Power line canceller instance
+ */
+typedef struct {
+    uint8_t harmonics;                          /*!< Number of cancelled harmonics */
+    float mu;                                   /*!< LMS step size */
+    float sample_freq;                          /*!< Signal's sample frequency */
+    float omega;                                /*!< Tracked line frequency (rad/sample) */
+    float omega_min;                            /*!< Minimum tracked line frequency (rad/sample) */
+    float omega_max;                            /*!< Maximum tracked line frequency (rad/sample) */
+    float osc_step[2];                          /*!< Oscillator phase increment exp(j*omega) (re, im) */
+    float osc[2];                               /*!< Oscillator current value (re, im) */
+    float weight[2 * POWERLINE_MAX_HARMONICS];  /*!< Weights of each harmonic (cosine, sine) */
+    float weight_prev[2];                       /*!< Fundamental's weights at last frequency update */
+    uint16_t count;                             /*!< Samples since last frequency update */
+} powerline_t;
+
+/**
+ * @brief Q15 power line canceller instance
+ */
+typedef struct {
+    uint8_t harmonics;                          /*!< Number of cancelled harmonics */
+    int32_t mu;                                 /*!< LMS step size (Q15) */
+    float sample_freq;                          /*!< Signal's sample frequency */
+    uint32_t phase;                             /*!< Oscillator phase (2^32 = 2*pi) */
+    uint32_t phase_step;                        /*!< Tracked line frequency (2^32 = sample_freq) */
+    uint32_t phase_step_min;                    /*!< Minimum tracked line frequency */
+    uint32_t phase_step_max;                    /*!< Maximum tracked line frequency */
+    int32_t weight[2 * POWERLINE_MAX_HARMONICS];/*!< Weights of each harmonic (cosine, sine), samples * 2^14 */
+    int32_t weight_prev[2];                     /*!< Fundamental's weights at last frequency update */
+    uint16_t count;                             /*!< Samples since last frequency update */
+} powerline_q15_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize a power line canceller
+ *
+ * @param pl            Pointer to power line canceller instance
+ * @param config        Pointer to configuration
+ * @return true         Canceller initialized
+ * @return false        Invalid configuration
+ */
+bool PowerlineInit(powerline_t * pl, powerline_config_t * config);
+
+/**
+ * @brief Remove power line interference from a signal array (state is kept between calls)
+ *
+ * @param pl                Pointer to power line canceller instance
+ * @param input_signal      Input signal array
+ * @param output_signal     Output signal array (can be the same as input_signal)
+ * @param signal_lenght     Number of samples of both signals
+ */
+void PowerlineFilter(powerline_t * pl, const float * input_signal, float * output_signal, int16_t signal_lenght);
+
+/**
+ * @brief Tracked line frequency
+ *
+ * @param pl            Pointer to power line canceller instance
+ * @return float        Line frequency (Hz)
+ */
+float PowerlineFrequency(powerline_t * pl);
+
+/**
+ * @brief Clear the weights (interference estimate) and restart the oscillator
+ *
+ * @param pl            Pointer to power line canceller instance
+ */
+void PowerlineReset(powerline_t * pl);
+
+/**
+ * @brief Initialize a Q15 power line canceller
+ *
+ * @param pl            Pointer to Q15 power line canceller instance
+ * @param config        Pointer to configuration
+ * @return true         Canceller initialized
+ * @return false        Invalid configuration
+ */
+bool PowerlineQ15Init(powerline_q15_t * pl, powerline_config_t * config);
+
+/**
+ * @brief Remove power line interference from a Q15 signal array (state is kept between calls)
+ *
+ * @param pl                Pointer to Q15 power line canceller instance
+ * @param input_signal      Input signal array
+ * @param output_signal     Output signal array (can be the same as input_signal)
+ * @param signal_lenght     Number of samples of both signals
+ */
+void PowerlineQ15Filter(powerline_q15_t * pl, const int16_t * input_signal, int16_t * output_signal, int16_t signal_lenght);
+
+/**
+ * @brief Tracked line frequency of a Q15 canceller
+ *
+ * @param pl            Pointer to Q15 power line canceller instance
+ * @return float        Line frequency (Hz)
+ */
+float PowerlineQ15Frequency(powerline_q15_t * pl);
+
+/**
+ * @brief Clear the weights (interference estimate) and restart the oscillator
+ *
+ * @param pl            Pointer to Q15 power line canceller instance
+ */
+void PowerlineQ15Reset(powerline_q15_t * pl);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* POWERLINE_H_ */
+
+/*==================[end of file]============================================*/
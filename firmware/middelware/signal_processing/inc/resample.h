@@ -0,0 +1,116 @@
+#ifndef RESAMPLE_H_
+#define RESAMPLE_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup Resample Resample
+ */
+
+/** \brief Sample rate conversion by a rational factor interp / decim
+ *
+ * Integer decimation (interp = 1), integer interpolation (decim = 1) or rational
+ * resampling, with a polyphase FIR bank: only the samples kept after decimation are
+ * computed, and the zeros inserted by interpolation are never multiplied. Each output
+ * sample costs one dot product of fir_lenght / interp taps (dsps_dotprod_f32()).
+ *
+ * The anti-alias / anti-imaging filter is a Blackman windowed sinc designed at init, with
+ * unity gain and its stop band starting at the lower Nyquist frequency
+ * (min(fs_in, fs_out) / 2): aliases are below -67 dB at that frequency and below -80 dB
+ * beyond it. With the default lenght the response is flat (+-0.001) up to half the lower
+ * Nyquist frequency and -0.1 dB at 0.6 of it; longer filters widen the pass band.
+ *
+ * Blocks of any lenght can be processed: filter state and output phase are kept between
+ * calls. Delay is (fir_lenght - 1) / (2 * interp) input samples.
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+#define RESAMPLE_MAX_FACTOR     64      /*!< Maximum interpolation and decimation factors (after reduction) */
+
+/*==================[typedef]================================================*/
+/**
+ * @brief Resampler config structure
+ */
+typedef struct {
+    uint16_t interp;            /*!< Interpolation factor L (fs_out = fs_in * interp / decim) */
+    uint16_t decim;             /*!< Decimation factor M */
+    uint16_t fir_lenght;        /*!< Filter taps at fs_in * interp (0 for default: 24 * max(interp, decim)) */
+} resample_config_t;
+
+/**
+ * @brief Resampler instance
+ */
+typedef struct {
+    uint16_t interp;            /*!< Interpolation factor (reduced) */
+    uint16_t decim;             /*!< Decimation factor (reduced) */
+    uint16_t taps;              /*!< Taps of each phase of the filter bank */
+    uint16_t phase;             /*!< Filter phase of next output sample (>= interp: input samples to skip) */
+    uint16_t pos;               /*!< Position of next input sample in delay line */
+    float * bank;               /*!< Filter bank (interp phases of taps coefficients, time reversed) */
+    float * delay;              /*!< Delay line (last taps input samples, stored twice) */
+} resample_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize a resampler and design its filter
+ *
+ * @param resample      Pointer to resampler instance
+ * @param config        Pointer to resampler configuration
+ * @return true         Resampler initialized
+ * @return false        Invalid configuration or not enough memory
+ */
+bool ResampleInit(resample_t * resample, resample_config_t * config);
+
+/**
+ * @brief Release the memory used by a resampler
+ *
+ * @param resample      Pointer to resampler instance
+ */
+void ResampleDeinit(resample_t * resample);
+
+/**
+ * @brief Maximum number of output samples for an input block
+ *
+ * @param resample      Pointer to resampler instance
+ * @param input_lenght  Number of input samples
+ * @return uint16_t     Maximum number of output samples (ceil(input_lenght * interp / decim))
+ */
+uint16_t ResampleOutputLenght(resample_t * resample, uint16_t input_lenght);
+
+/**
+ * @brief Resample a block of a signal (state is kept between calls)
+ *
+ * @param resample          Pointer to resampler instance
+ * @param input_signal      Input signal array
+ * @param input_lenght      Number of input samples
+ * @param output_signal     Output signal array (of lenght >= ResampleOutputLenght(), can't be input_signal)
+ * @return uint16_t         Number of output samples
+ */
+uint16_t ResampleProcess(resample_t * resample, const float * input_signal, uint16_t input_lenght, float * output_signal);
+
+/**
+ * @brief Clear filter state and restart output phase
+ *
+ * @param resample      Pointer to resampler instance
+ */
+void ResampleReset(resample_t * resample);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* RESAMPLE_H_ */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,119 @@
+#ifndef SLIDING_DFT_H_
+#define SLIDING_DFT_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup Sliding_DFT Sliding DFT
+ */
+
+/** \brief Sliding DFT bank for per-sample tracking of selected bins
+ *
+ * Keeps the DFT of the last window_lenght samples for a set of bins, updated with
+ * each new sample in O(number of bins) operations. Bin k corresponds to
+ * frequency k * sample_freq / window_lenght (same axis as FFTFrequency()).
+ *
+ * A damping factor slightly lower than 1 keeps the recursion stable against
+ * round-off error accumulation (e.g. 0.9999).
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+/**
+ * @brief Sliding DFT config structure
+ */
+typedef struct {
+    uint16_t window_lenght;     /*!< Number of samples of the DFT window */
+    const uint16_t * bins;      /*!< Array with the index of the bins to track (0 to window_lenght / 2 - 1) */
+    uint16_t n_bins;            /*!< Number of bins to track */
+    float damping;              /*!< Damping factor (0 < damping <= 1) */
+} sliding_dft_config_t;
+
+/**
+ * @brief Sliding DFT instance
+ */
+typedef struct {
+    uint16_t window_lenght;     /*!< Number of samples of the DFT window */
+    uint16_t n_bins;            /*!< Number of bins tracked */
+    uint16_t index;             /*!< Index of oldest sample in delay line */
+    float damping_n;            /*!< Damping factor raised to window_lenght */
+    float * delay;              /*!< Last window_lenght samples */
+    uint16_t * bins;            /*!< Index of each bin tracked */
+    float * coeff;              /*!< damping * exp(j*2*pi*k/N) for each bin (re, im) */
+    float * state;              /*!< DFT value of each bin (re, im) */
+} sliding_dft_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize a sliding DFT instance
+ *
+ * @param sdft      Pointer to sliding DFT instance
+ * @param config    Pointer to sliding DFT configuration
+ * @return true     Sliding DFT initialized
+ * @return false    Invalid configuration or not enough memory
+ */
+bool SlidingDFTInit(sliding_dft_t * sdft, sliding_dft_config_t * config);
+
+/**
+ * @brief Release the memory used by a sliding DFT instance
+ *
+ * @param sdft      Pointer to sliding DFT instance
+ */
+void SlidingDFTDeinit(sliding_dft_t * sdft);
+
+/**
+ * @brief Update all bins with a new sample
+ *
+ * @note  Placed in IRAM, can be called from an ISR (no memory allocation nor blocking calls)
+ *
+ * @param sdft      Pointer to sliding DFT instance
+ * @param sample    New sample
+ */
+void SlidingDFTUpdate(sliding_dft_t * sdft, float sample);
+
+/**
+ * @brief Calculate the magnitude of all bins
+ *
+ * @note  Same scaling as FFTMagnitude() (a sine of amplitude A centered on a bin
+ * returns 2 * A and a constant value D returns D on bin 0)
+ *
+ * @param sdft      Pointer to sliding DFT instance
+ * @param magnitude Array to store magnitude values (of lenght = n_bins)
+ */
+void SlidingDFTMagnitude(sliding_dft_t * sdft, float * magnitude);
+
+/**
+ * @brief Calculate the power (squared magnitude) of all bins
+ *
+ * @param sdft      Pointer to sliding DFT instance
+ * @param power     Array to store power values (of lenght = n_bins)
+ */
+void SlidingDFTPower(sliding_dft_t * sdft, float * power);
+
+/**
+ * @brief Clear the delay line and bin values
+ *
+ * @param sdft      Pointer to sliding DFT instance
+ */
+void SlidingDFTReset(sliding_dft_t * sdft);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* SLIDING_DFT_H_ */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,144 @@
+#ifndef SPECTRAL_FEATURES_H_
+#define SPECTRAL_FEATURES_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup Spectral_Features Spectral Features
+ */
+
+/** \brief Spectral features calculated in a single pass over a spectrum
+ *
+ * Mean frequency (MNF), median frequency (MDF), total and per band power, spectral
+ * spread and skewness, peak frequency and spectral entropy of a magnitude or power
+ * spectrum (as returned by FFTMagnitude(), FFTPlanPower() or FFTPlanQ15Magnitude()).
+ * Spectrum values are used as weights, so features of a magnitude spectrum differ
+ * from those of a power spectrum.
+ *
+ * The spectrum is read once while its cumulative sum is stored; median frequency and
+ * band powers are then obtained from the cumulative sum without reading the spectrum again.
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+#define SPECTRAL_MAX_BANDS      8       /*!< Maximum number of power bands */
+/*==================[typedef]================================================*/
+/**
+ * @brief Spectrum values format
+ */
+typedef enum spectral_format {
+    SPECTRAL_FLOAT,             /*!< float spectrum */
+    SPECTRAL_UINT16             /*!< uint16_t spectrum plus block exponent (integer operations only) */
+} spectral_format_t;
+
+/**
+ * @brief Frequency band
+ */
+typedef struct {
+    float f_low;                /*!< Lower frequency (Hz, included) */
+    float f_high;               /*!< Higher frequency (Hz, included) */
+} spectral_band_t;
+
+/**
+ * @brief Spectral features config structure
+ */
+typedef struct {
+    float sample_freq;          /*!< Signal's sample frequency */
+    uint16_t signal_lenght;     /*!< Lenght of the transformed signal (spectrum has signal_lenght / 2 bins) */
+    spectral_format_t format;   /*!< Spectrum values format */
+    float f_min;                /*!< Lower frequency analyzed (Hz) */
+    float f_max;                /*!< Higher frequency analyzed (Hz, 0 for sample_freq / 2) */
+    const spectral_band_t * bands;  /*!< Array of bands to calculate power (or NULL) */
+    uint8_t n_bands;            /*!< Number of bands (max SPECTRAL_MAX_BANDS) */
+    bool entropy;               /*!< Calculate spectral entropy (one log2 per bin) */
+} spectral_config_t;
+
+/**
+ * @brief Spectral features context
+ */
+typedef struct {
+    float freq_step;            /*!< Frequency resolution (Hz) */
+    spectral_format_t format;   /*!< Spectrum values format */
+    uint16_t bin_min;           /*!< First bin analyzed */
+    uint16_t bin_max;           /*!< Last bin analyzed */
+    uint8_t n_bands;            /*!< Number of bands */
+    uint16_t band_low[SPECTRAL_MAX_BANDS];  /*!< First bin of each band */
+    uint16_t band_high[SPECTRAL_MAX_BANDS]; /*!< Last bin of each band */
+    bool entropy;               /*!< Calculate spectral entropy */
+    float * cumulative;         /*!< Cumulative sum of float spectrum (NULL if not used) */
+    uint32_t * cumulative_int;  /*!< Cumulative sum of uint16_t spectrum (NULL if not used) */
+} spectral_ctx_t;
+
+/**
+ * @brief Spectral features
+ */
+typedef struct {
+    float total;                /*!< Sum of spectrum values in analyzed range */
+    float mean_freq;            /*!< Mean frequency (Hz) */
+    float median_freq;          /*!< Median frequency (Hz) */
+    float peak_freq;            /*!< Frequency of the maximum value (Hz) */
+    float peak_value;           /*!< Maximum value */
+    float spread;               /*!< Standard deviation of frequency around mean frequency (Hz) */
+    float skewness;             /*!< Skewness of the spectrum around mean frequency */
+    float entropy;              /*!< Spectral entropy (bits, 0 if not calculated) */
+    float band[SPECTRAL_MAX_BANDS]; /*!< Sum of spectrum values of each band */
+} spectral_features_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize a spectral features context
+ *
+ * @param ctx       Pointer to spectral features context
+ * @param config    Pointer to configuration
+ * @return true     Context initialized
+ * @return false    Invalid configuration or not enough memory
+ */
+bool SpectralFeaturesInit(spectral_ctx_t * ctx, spectral_config_t * config);
+
+/**
+ * @brief Release the memory used by a spectral features context
+ *
+ * @param ctx       Pointer to spectral features context
+ */
+void SpectralFeaturesDeinit(spectral_ctx_t * ctx);
+
+/**
+ * @brief Calculate the features of a float spectrum (format = SPECTRAL_FLOAT)
+ *
+ * @param ctx       Pointer to spectral features context
+ * @param spectrum  Array with spectrum values (of lenght = signal_lenght / 2)
+ * @param features  Pointer to store features
+ */
+void SpectralFeaturesCalc(spectral_ctx_t * ctx, const float * spectrum, spectral_features_t * features);
+
+/**
+ * @brief Calculate the features of a fixed point spectrum (format = SPECTRAL_UINT16)
+ *
+ * Only integer operations are used over the bins. Values (total, peak and bands) are scaled
+ * by 2^exponent, frequencies do not depend on the exponent.
+ *
+ * @param ctx       Pointer to spectral features context
+ * @param spectrum  Array with spectrum values (of lenght = signal_lenght / 2)
+ * @param exponent  Block exponent of spectrum values (as returned by FFTPlanQ15Magnitude())
+ * @param features  Pointer to store features
+ */
+void SpectralFeaturesCalcQ15(spectral_ctx_t * ctx, const uint16_t * spectrum, int8_t exponent, spectral_features_t * features);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* SPECTRAL_FEATURES_H_ */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,136 @@
+#ifndef STFT_H_
+#define STFT_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup STFT Short-Time Fourier Transform
+ */
+
+/** \brief Streaming short-time Fourier transform and Welch power spectrum
+ *
+ * Samples are pushed as they are acquired (one by one or in blocks) and a new
+ * power spectrum is calculated every "hop" samples over the last signal_lenght
+ * samples. Optionally, a running Welch average of the power spectra is kept.
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "fft.h"
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+/**
+ * @brief Welch average mode
+ */
+typedef enum stft_welch {
+    STFT_WELCH_OFF,             /*!< No average */
+    STFT_WELCH_CUMULATIVE,      /*!< Mean of all spectra since last reset */
+    STFT_WELCH_EXPONENTIAL      /*!< Exponential moving average (weight = welch_alpha) */
+} stft_welch_t;
+
+/**
+ * @brief STFT config structure
+ */
+typedef struct {
+    uint16_t signal_lenght;     /*!< Samples per spectrum (power of two, max MAX_SIGNAL_LENGHT) */
+    uint16_t hop;               /*!< Samples between spectra (e.g. signal_lenght/2 for 50% overlap) */
+    fft_window_t window;        /*!< Window applied to each frame */
+    stft_welch_t welch;         /*!< Welch average mode */
+    float welch_alpha;          /*!< Weight of new spectrum: 0 < welch_alpha <= 1 (only for STFT_WELCH_EXPONENTIAL) */
+    void *func_p;               /*!< Pointer to callback function called with each new spectrum: void func(float *power, void *param) (or NULL) */
+    void *param_p;              /*!< Pointer to callback function parameter */
+} stft_config_t;
+
+/**
+ * @brief STFT instance
+ */
+typedef struct {
+    fft_plan_t plan;            /*!< FFT plan of the frames */
+    uint16_t hop;               /*!< Samples between spectra */
+    uint16_t fill;              /*!< Samples stored in frame */
+    float * frame;              /*!< Last signal_lenght samples */
+    float * power;              /*!< Last power spectrum (signal_lenght / 2 values) */
+    float * welch;              /*!< Welch average power spectrum (signal_lenght / 2 values, NULL if off) */
+    stft_welch_t welch_mode;    /*!< Welch average mode */
+    float welch_alpha;          /*!< Weight of new spectrum for exponential average */
+    uint32_t spectra;           /*!< Number of spectra averaged in welch */
+    void (*func_p)(float *, void *);    /*!< Callback function for new spectrum */
+    void *param_p;              /*!< Callback function parameter */
+} stft_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize a STFT instance
+ *
+ * @note  FFTInit() must be called before
+ *
+ * @param stft      Pointer to STFT instance
+ * @param config    Pointer to STFT configuration
+ * @return true     STFT initialized
+ * @return false    Invalid configuration or not enough memory
+ */
+bool STFTInit(stft_t * stft, stft_config_t * config);
+
+/**
+ * @brief Release the memory used by a STFT instance
+ *
+ * @param stft      Pointer to STFT instance
+ */
+void STFTDeinit(stft_t * stft);
+
+/**
+ * @brief Push new samples into the STFT
+ *
+ * A power spectrum is calculated each time hop samples are completed (and the frame is full).
+ * The callback function (if any) is called with every new spectrum.
+ *
+ * @note  Must not be called from an ISR
+ *
+ * @param stft      Pointer to STFT instance
+ * @param samples   Array with new samples
+ * @param lenght    Number of new samples
+ * @return uint16_t Number of new spectra calculated
+ */
+uint16_t STFTPush(stft_t * stft, float * samples, uint16_t lenght);
+
+/**
+ * @brief Return the last power spectrum (of lenght = signal_lenght / 2)
+ *
+ * @param stft      Pointer to STFT instance
+ * @return float*   Pointer to last power spectrum
+ */
+float * STFTPower(stft_t * stft);
+
+/**
+ * @brief Return the Welch average power spectrum (of lenght = signal_lenght / 2)
+ *
+ * @param stft      Pointer to STFT instance
+ * @return float*   Pointer to average power spectrum (NULL if Welch average is off)
+ */
+float * STFTWelch(stft_t * stft);
+
+/**
+ * @brief Restart the Welch average and discard stored samples
+ *
+ * @param stft      Pointer to STFT instance
+ */
+void STFTReset(stft_t * stft);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* STFT_H_ */
+
+/*==================[end of file]============================================*/
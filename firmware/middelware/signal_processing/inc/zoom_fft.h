@@ -0,0 +1,138 @@
+#ifndef ZOOM_FFT_H_
+#define ZOOM_FFT_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup Zoom_FFT Zoom FFT
+ */
+
+/** \brief Spectrum of a narrow frequency band with fine resolution
+ *
+ * The band [f_low, f_high] is shifted to 0 Hz (mixing with a complex oscillator at the
+ * band center), low pass filtered and decimated (dsps_fird_f32()) and transformed with a
+ * fft_lenght points complex FFT. Resolution is sample_freq / (decim * fft_lenght), the same
+ * as a full band FFT of decim * fft_lenght samples, at the cost of a fft_lenght points FFT
+ * plus the decimation filter.
+ *
+ * The decimated band spans at least twice the requested band, so bins outside
+ * [f_low, f_high] (bins lower than bin_low or higher than bin_high) fall in the
+ * transition band of the decimation filter and should be discarded.
+ *
+ * Decimation is limited to ZOOM_FFT_MAX_DECIM (filter and mixing buffers grow with it): for
+ * narrower bands the decimated band is wider than needed and resolution is
+ * sample_freq / (ZOOM_FFT_MAX_DECIM * fft_lenght).
+ *
+ * Host test of tone bins and amplitude, out of band rejection and decimation limit in
+ * test/test_zoom_fft.c (make run).
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "fft.h"
+#include "dsps_fir.h"
+/*==================[macros]=================================================*/
+#define ZOOM_FFT_MAX_DECIM      256     /*!< Maximum decimation factor (default filter: 2817 taps, mixing buffer: 32 kB) */
+
+/*==================[typedef]================================================*/
+/**
+ * @brief Zoom FFT config structure
+ */
+typedef struct {
+    float sample_freq;          /*!< Signal's sample frequency */
+    float f_low;                /*!< Lower frequency of the band (Hz) */
+    float f_high;               /*!< Higher frequency of the band (Hz, max sample_freq / 2) */
+    uint16_t fft_lenght;        /*!< Number of bins (power of two, 16 to MAX_SIGNAL_LENGHT) */
+    fft_window_t window;        /*!< Window applied to decimated signal */
+    uint16_t fir_lenght;        /*!< Decimation filter taps (0 for default: 11 * decim + 1) */
+} zoom_fft_config_t;
+
+/**
+ * @brief Zoom FFT instance
+ */
+typedef struct {
+    uint16_t fft_lenght;        /*!< Number of bins */
+    uint16_t decim;             /*!< Decimation factor */
+    uint32_t signal_lenght;     /*!< Samples per spectrum (decim * fft_lenght) */
+    float f_center;             /*!< Center frequency of the band (Hz) */
+    float freq_step;            /*!< Frequency resolution (Hz) */
+    uint16_t bin_low;           /*!< First bin inside [f_low, f_high] */
+    uint16_t bin_high;          /*!< Last bin inside [f_low, f_high] */
+    float osc_step[2];          /*!< Oscillator phase increment exp(-j*2*pi*f_center/sample_freq) (re, im) */
+    float osc[2];               /*!< Oscillator current value (re, im) */
+    float * coeffs;             /*!< Decimation filter coefficients */
+    fir_f32_t fir_re;           /*!< Decimation filter of real part */
+    fir_f32_t fir_im;           /*!< Decimation filter of imaginary part */
+    float * mix;                /*!< Mixed samples of one chunk (real part, then imaginary part) */
+    float * decimated;          /*!< Decimated samples of one chunk (real part, then imaginary part) */
+    float * window;             /*!< Precomputed window (fft_lenght values) */
+    float * data;               /*!< Complex FFT buffer (2 * fft_lenght values) */
+} zoom_fft_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize a zoom FFT instance
+ *
+ * @note  FFTInit() must be called before
+ *
+ * @param zoom      Pointer to zoom FFT instance
+ * @param config    Pointer to zoom FFT configuration
+ * @return true     Zoom FFT initialized
+ * @return false    Invalid configuration or not enough memory
+ */
+bool ZoomFFTInit(zoom_fft_t * zoom, zoom_fft_config_t * config);
+
+/**
+ * @brief Release the memory used by a zoom FFT instance
+ *
+ * @param zoom      Pointer to zoom FFT instance
+ */
+void ZoomFFTDeinit(zoom_fft_t * zoom);
+
+/**
+ * @brief Calculate the magnitude of the band's spectrum
+ *
+ * Oscillator phase and filter state are kept between calls, so consecutive blocks of a
+ * continuous signal are processed without transients (the first spectrum after init or
+ * reset includes the filter start up).
+ *
+ * @note  Same scaling as FFTMagnitude() (a sine of amplitude A returns 2 * A with Hann window)
+ *
+ * @param zoom      Pointer to zoom FFT instance
+ * @param signal    Array with signal values (of lenght = zoom->signal_lenght)
+ * @param fft       Array to store magnitude values (of lenght = zoom->fft_lenght), from lower to higher frequency
+ */
+void ZoomFFTMagnitude(zoom_fft_t * zoom, const float * signal, float * fft);
+
+/**
+ * @brief Return the zoom FFT frequency axis vector
+ *
+ * @param zoom      Pointer to zoom FFT instance
+ * @param f         Array to store frequency values (of lenght = zoom->fft_lenght)
+ */
+void ZoomFFTFrequency(zoom_fft_t * zoom, float * f);
+
+/**
+ * @brief Restart oscillator phase and clear filter state
+ *
+ * @param zoom      Pointer to zoom FFT instance
+ */
+void ZoomFFTReset(zoom_fft_t * zoom);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* ZOOM_FFT_H_ */
+
+/*==================[end of file]============================================*/
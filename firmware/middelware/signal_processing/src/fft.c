@@ -10,53 +10,464 @@
  */
 
 /*==================[inclusions]=============================================*/
+#include <stdlib.h>
 #include <string.h>
 #include <math.h>
 #include "fft.h"
+#include "fft_static.h"
 #include "esp_dsp.h"
 #include "esp_log.h"
 /*==================[macros and definitions]=================================*/
 #define TAG "FFT Module"
+#define BYTES_PER_CPLX  (2 * sizeof(float))     /*!< Bit reverse tables store byte offsets */
+/* Kernels taking the tables as parameter (used by plans) */
+#if CONFIG_DSP_OPTIMIZED && (dsps_fft4r_fc32_ae32_enabled == 1)
+#define FFT4R_KERNEL    dsps_fft4r_fc32_ae32_
+#else
+#define FFT4R_KERNEL    dsps_fft4r_fc32_ansi_
+#endif
+#if CONFIG_DSP_OPTIMIZED && (dsps_fft2r_fc32_aes3_enabled == 1)
+#define FFT2R_KERNEL    dsps_fft2r_fc32_aes3_
+#elif CONFIG_DSP_OPTIMIZED && (dsps_fft2r_fc32_ae32_enabled == 1)
+#define FFT2R_KERNEL    dsps_fft2r_fc32_ae32_
+#else
+#define FFT2R_KERNEL    dsps_fft2r_fc32_ansi_
+#endif
+#if CONFIG_DSP_OPTIMIZED && (dsps_cplx2real_fc32_ae32_enabled == 1)
+#define CPLX2REAL_KERNEL    dsps_cplx2real_fc32_ae32_
+#else
+#define CPLX2REAL_KERNEL    dsps_cplx2real_fc32_ansi_
+#endif
+#if CONFIG_DSP_OPTIMIZED && (dsps_fft2r_sc16_aes3_enabled == 1)
+#define FFT2R_SC16_KERNEL   dsps_fft2r_sc16_aes3_
+#elif CONFIG_DSP_OPTIMIZED && (dsps_fft2r_sc16_ae32_enabled == 1)
+#define FFT2R_SC16_KERNEL   dsps_fft2r_sc16_ae32_
+#else
+#define FFT2R_SC16_KERNEL   dsps_fft2r_sc16_ansi_
+#endif
+#define Q15_ONE         32767
 /*==================[internal data declaration]==============================*/
-static float fft_complex[2 * MAX_SIGNAL_LENGHT];
+static float fft_complex[MAX_SIGNAL_LENGHT];
 static float wind[MAX_SIGNAL_LENGHT];
+static uint16_t wind_lenght = 0;
+#if CONFIG_FFT_CONST_TABLES
+/* Generated at compile time (fft_tables.cpp) */
+extern const float * const fft_const_w_table_r2;
+extern const float * const fft_const_w_table_r4;
+#endif
 /*==================[internal functions declaration]=========================*/
+/**
+ * @brief Calculates the spectrum of a real signal of N samples using a N/2 points complex FFT
+ *
+ * @note Even samples are packed as real part and odd samples as imaginary part. After the
+ * complex FFT, dsps_cplx2real_fc32() splits the result into the N/2 first bins of the
+ * N points real spectrum (bin 0 holds DC as real part and Nyquist as imaginary part).
+ *
+ * @param data              Array with signal values packed as complex (of lenght = signal_lenght)
+ * @param signal_lenght     Number of real samples
+ */
+static void FFTReal(float * data, uint16_t signal_lenght);
+
+/**
+ * @brief Calculates the magnitude of the spectrum returned by FFTReal()
+ *
+ * @param data              Spectrum returned by FFTReal()
+ * @param fft               Array to store FFT magnitude values (of lenght = signal_lenght / 2)
+ * @param signal_lenght     Number of real samples
+ */
+static void FFTRealMagnitude(float * data, float * fft, uint16_t signal_lenght);
 
+/**
+ * @brief Fill a bit reverse swap table (same format as esp-dsp tables)
+ *
+ * @param table             Array to store swaps (NULL to only count them)
+ * @param n_cplx            Number of complex points of the FFT
+ * @param radix4            Digit reverse for radix-4 (true) or bit reverse for radix-2 (false)
+ * @return uint16_t         Number of swaps
+ */
+static uint16_t FFTBitRevGen(uint16_t * table, uint16_t n_cplx, bool radix4);
+
+/**
+ * @brief Window a signal and calculate its spectrum in the plan's scratch buffer
+ * 
+ * @param plan              Pointer to initialized plan
+ * @param signal            Array with signal values (of lenght = plan->signal_lenght)
+ */
+static void FFTPlanTransform(fft_plan_t * plan, float * signal);
+
+/**
+ * @brief Split the N/2 points fixed point FFT of a packed real signal into its N points spectrum
+ * 
+ * @note Same as dsps_cplx2real_sc16_ansi(), but using the plan's twiddle table. Result is 
+ * scaled by 1/2 (as every FFT stage).
+ * 
+ * @param data              Result of the N/2 points complex FFT (in natural order)
+ * @param n_cplx            Number of complex points
+ * @param table             Bit reversed Q15 sin/cos table of at least n_cplx complex values
+ */
+static void FFTQ15RealSplit(int16_t * data, uint16_t n_cplx, int16_t * table);
 /*==================[internal data definition]===============================*/
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+static void FFTReal(float * data, uint16_t signal_lenght){
+    int n_cplx = signal_lenght / 2;
+    // Radix-4 kernel only accepts power of 4 lenghts, use radix-2 otherwise
+    if((dsp_power_of_two(n_cplx) & 0x01) == 0){
+        dsps_fft4r_fc32(data, n_cplx);
+        dsps_bit_rev4r_fc32(data, n_cplx);
+    }
+    else{
+        dsps_fft2r_fc32(data, n_cplx);
+        dsps_bit_rev2r_fc32(data, n_cplx);
+    }
+    dsps_cplx2real_fc32(data, n_cplx);
+}
+
+static void FFTRealMagnitude(float * data, float * fft, uint16_t signal_lenght){
+    // Bin 0 only holds DC as real part
+    float scale = 8.0f / signal_lenght;
+    fft[0] = fabsf(data[0]) * 2.0f / signal_lenght;
+    for (int j = 1; j < signal_lenght / 2; j++){
+        fft[j] = scale * sqrtf(data[j*2+0]*data[j*2+0] + data[j*2+1]*data[j*2+1]);
+    }
+}
+
+static uint16_t FFTBitRevGen(uint16_t * table, uint16_t n_cplx, bool radix4){
+    int log2n = dsp_power_of_two(n_cplx);
+    uint16_t count = 0;
+    for(int i = 1; i < n_cplx - 1; i++){
+        int rev = 0;
+        int j = i;
+        if(radix4){
+            for(int d = 0; d < log2n / 2; d++){
+                rev = (rev << 2) | (j & 0x3);
+                j >>= 2;
+            }
+        }
+        else{
+            for(int d = 0; d < log2n; d++){
+                rev = (rev << 1) | (j & 0x1);
+                j >>= 1;
+            }
+        }
+        if(i < rev){
+            if(table != NULL){
+                table[2 * count + 0] = i * BYTES_PER_CPLX;
+                table[2 * count + 1] = rev * BYTES_PER_CPLX;
+            }
+            count++;
+        }
+    }
+    return count;
+}
+
+static void FFTPlanTransform(fft_plan_t * plan, float * signal){
+    uint16_t n_cplx = plan->signal_lenght / 2;
+    // Multiply input array with window (real signal packed as N/2 complex values)
+    dsps_mul_f32(signal, plan->window, plan->scratch, plan->signal_lenght, 1, 1, 1);
+    // Calculate FFT with the fixed size kernels (usual lenghts) or with the plan's tables
+    if (!FFTStaticTransform(plan->scratch, n_cplx)){
+        if (plan->twiddle_r2 == NULL){
+            FFT4R_KERNEL(plan->scratch, n_cplx, plan->twiddle, plan->signal_lenght);
+        }
+        else{
+            FFT2R_KERNEL(plan->scratch, n_cplx, plan->twiddle_r2);
+        }
+        dsps_bit_rev_lookup_fc32(plan->scratch, plan->bit_rev_size, plan->bit_rev);
+    }
+    CPLX2REAL_KERNEL(plan->scratch, n_cplx, plan->twiddle, plan->signal_lenght);
+}
+
+static void FFTQ15RealSplit(int16_t * data, uint16_t n_cplx, int16_t * table){
+    sc16_t * w = (sc16_t *)table;
+    sc16_t * result = (sc16_t *)data;
+    int order = dsp_power_of_two(n_cplx);
+    int16_t tmp_re = result[0].re;
+    result[0].re = (tmp_re + result[0].im) >> 1;
+    result[0].im = (tmp_re - result[0].im) >> 1;
+    for (int k = 1; k <= n_cplx / 2; k++){
+        sc16_t fpk = result[k];
+        sc16_t fpnk = result[n_cplx - k];
+        int f1k_re = fpk.re + fpnk.re;
+        int f1k_im = fpk.im - fpnk.im;
+        int f2k_re = fpk.re - fpnk.re;
+        int f2k_im = fpk.im + fpnk.im;
+        // Bit reversed table: first n_cplx values are the twiddles of a N points FFT
+        int rev = 0;
+        for (int b = 0, j = k; b < order; b++, j >>= 1){
+            rev = (rev << 1) | (j & 0x1);
+        }
+        sc16_t tw = w[rev];
+        int tw_re = (tw.re * f2k_im - tw.im * f2k_re) >> 15;
+        int tw_im = (tw.re * f2k_re + tw.im * f2k_im) >> 15;
+        result[k].re = (f1k_re + tw_re) >> 2;
+        result[k].im = (f1k_im - tw_im) >> 2;
+        result[n_cplx - k].re = (f1k_re - tw_re) >> 2;
+        result[n_cplx - k].im = -(f1k_im + tw_im) >> 2;
+    }
+}
 
 /*==================[external functions definition]==========================*/
 bool FFTInit(void){
+#if CONFIG_FFT_CONST_TABLES
+    // Tables already in flash: nothing to allocate nor calculate (unless esp-dsp was initialized before)
+    if (!dsps_fft2r_initialized){
+        dsps_fft_w_table_fc32 = (float *)fft_const_w_table_r2;
+        dsps_fft_w_table_size = CONFIG_DSP_MAX_FFT_SIZE;
+        dsps_fft2r_initialized = 1;
+    }
+    // Real signals are transformed as complex signals of half lenght
+    if (!dsps_fft4r_initialized){
+        dsps_fft4r_w_table_fc32 = (float *)fft_const_w_table_r4;
+        dsps_fft4r_w_table_size = MAX_SIGNAL_LENGHT;
+        dsps_fft4r_initialized = 1;
+    }
+#else
     esp_err_t ret = dsps_fft2r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE);
     if (ret != ESP_OK){
         return false;
     }
+    // Real signals are transformed as complex signals of half lenght
+    ret = dsps_fft4r_init_fc32(NULL, MAX_SIGNAL_LENGHT / 2);
+    if (ret != ESP_OK){
+        return false;
+    }
+#endif
     return true;
 }
 
 void FFTMagnitude(float * signal, float * fft, uint16_t signal_lenght){
-    // Generate Hann window
-    dsps_wind_hann_f32(wind, signal_lenght);
-    // Clear fft array
-    memset(fft_complex, 0, 2 * MAX_SIGNAL_LENGHT * sizeof(float));
-    // Multiply input array with window and store as real part
-    dsps_mul_f32(signal, wind, fft_complex, signal_lenght, 1, 1, 2);    
-    // Calculate FFT  
-    dsps_fft2r_fc32(fft_complex, signal_lenght);
-    // Bit reverse
-    dsps_bit_rev_fc32(fft_complex, signal_lenght);
-    // Convert one complex vector to two complex vectors
-    dsps_cplx2reC_fc32(fft_complex, signal_lenght);
-    // Calculate FFT magnitude 
-    for (int j = 0; j < signal_lenght; j++){
-            fft_complex[j] = 2*(sqrt(fft_complex[j*2+0]*fft_complex[j*2+0] + fft_complex[j*2+1]*fft_complex[j*2+1])) / (signal_lenght/2);
-    }
-    fft_complex[0] = fft_complex[0] / 2;
-    // Copy result in fft array
-    memcpy(fft, fft_complex, (signal_lenght / 2) * sizeof(float));
+    // Generate Hann window (only when lenght changes)
+    if (wind_lenght != signal_lenght){
+        dsps_wind_hann_f32(wind, signal_lenght);
+        wind_lenght = signal_lenght;
+    }
+    // Multiply input array with window (real signal packed as N/2 complex values)
+    dsps_mul_f32(signal, wind, fft_complex, signal_lenght, 1, 1, 1);
+    // Calculate FFT
+    FFTReal(fft_complex, signal_lenght);
+    // Calculate FFT magnitude
+    FFTRealMagnitude(fft_complex, fft, signal_lenght);
+}
+
+bool FFTPlanInit(fft_plan_t * plan, uint16_t signal_lenght, fft_window_t window){
+    uint16_t n_cplx = signal_lenght / 2;
+    memset(plan, 0, sizeof(fft_plan_t));
+    if (!dsp_is_power_of_two(signal_lenght) || (signal_lenght < 8) || (signal_lenght > MAX_SIGNAL_LENGHT)){
+        ESP_LOGE(TAG, "Invalid signal lenght: %d", signal_lenght);
+        return false;
+    }
+    bool radix4 = (dsp_power_of_two(n_cplx) & 0x01) == 0;
+    // Two real signals are packed in one radix-4 FFT of signal_lenght points (if possible)
+    bool dual = !radix4;
+    plan->signal_lenght = signal_lenght;
+    plan->window_type = window;
+    plan->bit_rev_size = FFTBitRevGen(NULL, n_cplx, radix4);
+    plan->window = malloc(signal_lenght * sizeof(float));
+    plan->twiddle = malloc(2 * signal_lenght * sizeof(float));
+    plan->scratch = malloc((dual ? 2 : 1) * signal_lenght * sizeof(float));
+    plan->bit_rev = malloc(2 * plan->bit_rev_size * sizeof(uint16_t));
+    if (!radix4){
+        plan->twiddle_r2 = malloc(n_cplx * sizeof(float));
+    }
+    if (dual){
+        plan->bit_rev_dual_size = FFTBitRevGen(NULL, signal_lenght, true);
+        plan->bit_rev_dual = malloc(2 * plan->bit_rev_dual_size * sizeof(uint16_t));
+    }
+    if ((plan->window == NULL) || (plan->twiddle == NULL) || (plan->scratch == NULL) ||
+        (plan->bit_rev == NULL) || (!radix4 && (plan->twiddle_r2 == NULL)) ||
+        (dual && (plan->bit_rev_dual == NULL))){
+        ESP_LOGE(TAG, "Not enough memory for FFT plan of %d points", signal_lenght);
+        FFTPlanDeinit(plan);
+        return false;
+    }
+    FFTWindow(plan->window, window, signal_lenght);
+    // Table of signal_lenght complex values: twiddles for the N/2 points radix-4 FFT
+    // and the N points real split (same layout as dsps_fft4r_init_fc32())
+    for (int i = 0; i < signal_lenght; i++){
+        float angle = 2 * M_PI * i / (float)signal_lenght;
+        plan->twiddle[2 * i + 0] = cosf(angle);
+        plan->twiddle[2 * i + 1] = sinf(angle);
+    }
+    if (!radix4){
+        // Same layout as dsps_fft2r_init_fc32()
+        dsps_gen_w_r2_fc32(plan->twiddle_r2, n_cplx);
+        dsps_bit_rev_fc32_ansi(plan->twiddle_r2, n_cplx >> 1);
+    }
+    FFTBitRevGen(plan->bit_rev, n_cplx, radix4);
+    if (dual){
+        FFTBitRevGen(plan->bit_rev_dual, signal_lenght, true);
+    }
+    return true;
+}
+
+void FFTPlanDeinit(fft_plan_t * plan){
+    free(plan->window);
+    free(plan->twiddle);
+    free(plan->twiddle_r2);
+    free(plan->bit_rev);
+    free(plan->bit_rev_dual);
+    free(plan->scratch);
+    memset(plan, 0, sizeof(fft_plan_t));
+}
+
+void FFTPlanMagnitude(fft_plan_t * plan, float * signal, float * fft){
+    FFTPlanTransform(plan, signal);
+    // Calculate FFT magnitude
+    FFTRealMagnitude(plan->scratch, fft, plan->signal_lenght);
+}
+
+void FFTPlanMagnitudeDual(fft_plan_t * plan, float * signal_a, float * signal_b, float * fft_a, float * fft_b){
+    if (plan->bit_rev_dual == NULL){
+        FFTPlanMagnitude(plan, signal_a, fft_a);
+        FFTPlanMagnitude(plan, signal_b, fft_b);
+        return;
+    }
+    uint16_t n = plan->signal_lenght;
+    float * data = plan->scratch;
+    // Multiply input arrays with window, store first signal as real part and second as imaginary part
+    dsps_mul_f32(signal_a, plan->window, &data[0], n, 1, 1, 2);
+    dsps_mul_f32(signal_b, plan->window, &data[1], n, 1, 1, 2);
+    // Calculate FFT of signal_lenght points (twiddle table holds signal_lenght complex values)
+    FFT4R_KERNEL(data, n, plan->twiddle, n);
+    dsps_bit_rev_lookup_fc32(data, plan->bit_rev_dual_size, plan->bit_rev_dual);
+    // Separate spectra: A[k] = (Z[k] + conj(Z[N-k])) / 2, B[k] = (Z[k] - conj(Z[N-k])) / 2j
+    float scale = 4.0f / n;
+    fft_a[0] = fabsf(data[0]) * 2.0f / n;
+    fft_b[0] = fabsf(data[1]) * 2.0f / n;
+    for (int k = 1; k < n / 2; k++){
+        float zk_re = data[2*k+0];
+        float zk_im = data[2*k+1];
+        float znk_re = data[2*(n-k)+0];
+        float znk_im = data[2*(n-k)+1];
+        float a_re = zk_re + znk_re;
+        float a_im = zk_im - znk_im;
+        float b_re = zk_re - znk_re;
+        float b_im = zk_im + znk_im;
+        fft_a[k] = scale * sqrtf(a_re * a_re + a_im * a_im);
+        fft_b[k] = scale * sqrtf(b_re * b_re + b_im * b_im);
+    }
+}
+
+void FFTPlanPower(fft_plan_t * plan, float * signal, float * power){
+    FFTPlanTransform(plan, signal);
+    // Same scaling as FFTPlanMagnitude(), without the square root
+    float scale = 8.0f / plan->signal_lenght;
+    float * data = plan->scratch;
+    scale = scale * scale;
+    power[0] = data[0] * data[0] * scale / 16;
+    for (int j = 1; j < plan->signal_lenght / 2; j++){
+        power[j] = scale * (data[j*2+0]*data[j*2+0] + data[j*2+1]*data[j*2+1]);
+    }
+}
+
+bool FFTPlanQ15Init(fft_plan_q15_t * plan, uint16_t signal_lenght, fft_window_t window){
+    memset(plan, 0, sizeof(fft_plan_q15_t));
+    if (!dsp_is_power_of_two(signal_lenght) || (signal_lenght < 8) || (signal_lenght > MAX_SIGNAL_LENGHT)){
+        ESP_LOGE(TAG, "Invalid signal lenght: %d", signal_lenght);
+        return false;
+    }
+    // Fixed point kernel only checks the library has been initialized (plans use their own table)
+    if (dsps_fft2r_init_sc16(NULL, MAX_SIGNAL_LENGHT) != ESP_OK){
+        return false;
+    }
+    plan->signal_lenght = signal_lenght;
+    plan->window_type = window;
+    plan->window = malloc(signal_lenght * sizeof(int16_t));
+    plan->twiddle = malloc(signal_lenght * sizeof(int16_t));
+    plan->scratch = malloc(signal_lenght * sizeof(int16_t));
+    float * wind_f32 = malloc(signal_lenght * sizeof(float));
+    if ((plan->window == NULL) || (plan->twiddle == NULL) || (plan->scratch == NULL) || (wind_f32 == NULL)){
+        ESP_LOGE(TAG, "Not enough memory for FFT plan of %d points", signal_lenght);
+        free(wind_f32);
+        FFTPlanQ15Deinit(plan);
+        return false;
+    }
+    FFTWindow(wind_f32, window, signal_lenght);
+    for (uint16_t i = 0; i < signal_lenght; i++){
+        plan->window[i] = (int16_t)(wind_f32[i] * Q15_ONE);
+    }
+    free(wind_f32);
+    // Same layout as dsps_fft2r_init_sc16()
+    dsps_gen_w_r2_sc16(plan->twiddle, signal_lenght);
+    dsps_bit_rev_sc16_ansi(plan->twiddle, signal_lenght >> 1);
+    return true;
+}
+
+void FFTPlanQ15Deinit(fft_plan_q15_t * plan){
+    free(plan->window);
+    free(plan->twiddle);
+    free(plan->scratch);
+    memset(plan, 0, sizeof(fft_plan_q15_t));
+}
+
+int8_t FFTPlanQ15Magnitude(fft_plan_q15_t * plan, const int16_t * signal, uint16_t * fft){
+    uint16_t n_cplx = plan->signal_lenght / 2;
+    int16_t * data = plan->scratch;
+    // Normalize frame to use the full 16 bits range (block floating point)
+    int32_t max = 0;
+    for (uint16_t i = 0; i < plan->signal_lenght; i++){
+        int32_t abs_val = (signal[i] < 0) ? -signal[i] : signal[i];
+        if (abs_val > max){
+            max = abs_val;
+        }
+    }
+    int8_t shift = 0;
+    while ((max != 0) && ((max << (shift + 1)) <= INT16_MAX)){
+        shift++;
+    }
+    // Multiply input array with window (real signal packed as N/2 complex values)
+    for (uint16_t i = 0; i < plan->signal_lenght; i++){
+        data[i] = ((int32_t)signal[i] * (1 << shift) * plan->window[i]) >> 15;
+    }
+    // Calculate FFT (scaled by 1/2 on each stage)
+    if (!FFTStaticTransformQ15(data, n_cplx)){
+        FFT2R_SC16_KERNEL(data, n_cplx, plan->twiddle);
+        dsps_bit_rev_sc16_ansi(data, n_cplx);
+    }
+    FFTQ15RealSplit(data, n_cplx, plan->twiddle);
+    // Calculate FFT magnitude: data = X / N * 2^shift, FFTMagnitude() = 8 / N * |X|
+    for (uint16_t j = 0; j < n_cplx; j++){
+        int32_t re = data[j*2+0] < 0 ? -data[j*2+0] : data[j*2+0];
+        int32_t im = data[j*2+1] < 0 ? -data[j*2+1] : data[j*2+1];
+        if (j == 0){
+            // Bin 0 only holds DC as real part (FFTMagnitude() = 2 / N * |X|)
+            fft[j] = re >> 2;
+            continue;
+        }
+        int32_t hi = (re > im) ? re : im;
+        int32_t lo = (re > im) ? im : re;
+        int32_t mag = hi - (hi >> 3) + (lo >> 1);
+        fft[j] = (mag > hi) ? mag : hi;
+    }
+    return 3 - shift;
+}
+
+void FFTWindow(float * window, fft_window_t type, uint16_t lenght){
+    switch(type){
+        case FFT_WINDOW_NONE:
+            for(uint16_t i=0; i<lenght; i++){
+                window[i] = 1.0f;
+            }
+        break;
+        case FFT_WINDOW_HANN:
+            dsps_wind_hann_f32(window, lenght);
+        break;
+        case FFT_WINDOW_BLACKMAN:
+            dsps_wind_blackman_f32(window, lenght);
+        break;
+        case FFT_WINDOW_BLACKMAN_HARRIS:
+            dsps_wind_blackman_harris_f32(window, lenght);
+        break;
+        case FFT_WINDOW_NUTTALL:
+            dsps_wind_nuttall_f32(window, lenght);
+        break;
+        case FFT_WINDOW_FLAT_TOP:
+            dsps_wind_flat_top_f32(window, lenght);
+        break;
+    }
 }
 
 void FFTFrequency(float sample_freq, uint16_t signal_lenght, float * f){
@@ -66,4 +477,4 @@ void FFTFrequency(float sample_freq, uint16_t signal_lenght, float * f){
     }
 }
 
-/*==================[end of file]============================================*/
\ No newline at end of file
+/*==================[end of file]============================================*/
@@ -0,0 +1,86 @@
+/**
+ * @file fft_static.cpp
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "fft_static.h"
+#include "fft_static.hpp"
+/*==================[macros and definitions]=================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+void FFTStatic256(float * data){
+    fft_static::fft<256, float>::Transform(data);
+}
+
+void FFTStatic512(float * data){
+    fft_static::fft<512, float>::Transform(data);
+}
+
+void FFTStatic1024(float * data){
+    fft_static::fft<1024, float>::Transform(data);
+}
+
+void FFTStatic256Q15(int16_t * data){
+    fft_static::fft<256, int16_t>::Transform(data);
+}
+
+void FFTStatic512Q15(int16_t * data){
+    fft_static::fft<512, int16_t>::Transform(data);
+}
+
+void FFTStatic1024Q15(int16_t * data){
+    fft_static::fft<1024, int16_t>::Transform(data);
+}
+
+bool FFTStaticTransform(float * data, uint16_t n_cplx){
+    switch(n_cplx){
+        case 256:
+            FFTStatic256(data);
+        break;
+        case 512:
+            FFTStatic512(data);
+        break;
+        case 1024:
+            FFTStatic1024(data);
+        break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+bool FFTStaticTransformQ15(int16_t * data, uint16_t n_cplx){
+    switch(n_cplx){
+        case 256:
+            FFTStatic256Q15(data);
+        break;
+        case 512:
+            FFTStatic512Q15(data);
+        break;
+        case 1024:
+            FFTStatic1024Q15(data);
+        break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,78 @@
+/**
+ * @file fft_tables.cpp
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Twiddle tables used by FFTInit(), calculated by the compiler (CONFIG_FFT_CONST_TABLES)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "sdkconfig.h"
+#include "dsps_fft2r.h"
+#include "fft.h"
+#include "fft_static.hpp"
+
+#if CONFIG_FFT_CONST_TABLES
+/*==================[macros and definitions]=================================*/
+namespace {
+
+/**
+ * @brief Table of n complex values (re, im)
+ */
+template <int n>
+struct TwiddleTable {
+    float w[2 * n];
+};
+
+/*==================[internal functions definition]==========================*/
+using fft_static::Angle;
+using fft_static::BitReverse;
+using fft_static::Cos;
+using fft_static::Log2;
+using fft_static::Sin;
+
+/**
+ * @brief Radix-2 table of table_size floats, same values as
+ * dsps_gen_w_r2_fc32() followed by dsps_bit_rev_fc32_ansi() (dsps_fft2r_init_fc32())
+ */
+template <int table_size>
+constexpr TwiddleTable<table_size / 2> TwiddleR2(){
+    TwiddleTable<table_size / 2> table{};
+    constexpr int bits = Log2(table_size / 2);
+    for (int i = 0; i < table_size / 2; i++){
+        double angle = Angle(BitReverse(i, bits), table_size);
+        table.w[2 * i + 0] = Cos(angle);
+        table.w[2 * i + 1] = Sin(angle);
+    }
+    return table;
+}
+
+/**
+ * @brief Radix-4 table of 2 * max_fft_size complex values, same values as dsps_fft4r_init_fc32()
+ */
+template <int max_fft_size>
+constexpr TwiddleTable<2 * max_fft_size> TwiddleR4(){
+    TwiddleTable<2 * max_fft_size> table{};
+    for (int i = 0; i < 2 * max_fft_size; i++){
+        double angle = Angle(i, 2 * max_fft_size);
+        table.w[2 * i + 0] = Cos(angle);
+        table.w[2 * i + 1] = Sin(angle);
+    }
+    return table;
+}
+
+/*==================[internal data definition]===============================*/
+constexpr TwiddleTable<CONFIG_DSP_MAX_FFT_SIZE / 2> w_table_r2 = TwiddleR2<CONFIG_DSP_MAX_FFT_SIZE>();
+constexpr TwiddleTable<MAX_SIGNAL_LENGHT> w_table_r4 = TwiddleR4<MAX_SIGNAL_LENGHT / 2>();
+
+} // namespace
+
+/*==================[external data definition]===============================*/
+extern "C" const float * const fft_const_w_table_r2 = w_table_r2.w;
+extern "C" const float * const fft_const_w_table_r4 = w_table_r4.w;
+
+#endif /* CONFIG_FFT_CONST_TABLES */
+/*==================[end of file]============================================*/
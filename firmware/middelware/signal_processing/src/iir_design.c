@@ -0,0 +1,450 @@
+/**
+ * @file iir_design.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+#include "iir_design.h"
+#include "esp_log.h"
+/*==================[macros and definitions]=================================*/
+#define TAG "IIR Design Module"
+#define IIR_DESIGN_MAX_ROOTS    (2 * IIR_MAX_SOS)   /*!< Maximum number of poles (and zeros) */
+#define IIR_DESIGN_ITERATIONS   500                 /*!< Maximum iterations of polynomial root finding */
+#define IIR_DESIGN_REAL_TOL     1e-9                /*!< Roots with smaller imaginary part are real */
+
+/**
+ * @brief Poles and zeros of a filter (s or z plane)
+ */
+typedef struct {
+    double complex p[IIR_DESIGN_MAX_ROOTS];     /*!< Poles */
+    double complex z[IIR_DESIGN_MAX_ROOTS];     /*!< Finite zeros */
+    uint8_t n_p;                                /*!< Number of poles */
+    uint8_t n_z;                                /*!< Number of finite zeros */
+} iir_zp_t;
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+/**
+ * @brief Analog low pass prototype (cut-off 1 rad/s)
+ *
+ * @param zp        Poles and zeros of the prototype
+ * @param config    Pointer to design configuration
+ * @return double   Prototype gain at DC
+ */
+static double IirPrototype(iir_zp_t * zp, iir_design_config_t * config);
+
+/**
+ * @brief Poles of a Bessel filter with -3 dB at 1 rad/s (roots of the reverse Bessel polynomial)
+ */
+static void IirBesselPoles(double complex * p, uint8_t n);
+
+/**
+ * @brief Low pass prototype to low pass, hi pass, band pass or band stop (analog, pre-warped edges)
+ */
+static void IirTransform(iir_zp_t * zp, iir_filter_type_t type, double w1, double w2);
+
+/**
+ * @brief Bilinear transform (s = 2 (z - 1) / (z + 1)), zeros at infinity are placed at z = -1
+ */
+static void IirBilinear(iir_zp_t * zp);
+
+/**
+ * @brief Pair poles and zeros into sections, ordered by increasing pole radius
+ *
+ * @param zp        Digital poles and zeros
+ * @param coeff     Coefficients of each section (b0, b1, b2, a1, a2)
+ * @return uint8_t  Number of sections
+ */
+static uint8_t IirPairSections(iir_zp_t * zp, float * coeff);
+
+/**
+ * @brief Scale a section to a given gain at frequency w_ref (rad/sample)
+ */
+static void IirSectionGain(float * coeff, double w_ref, double gain);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static double IirPrototype(iir_zp_t * zp, iir_design_config_t * config){
+    uint8_t n = config->order;
+    double dc_gain = 1;
+    zp->n_p = n;
+    zp->n_z = 0;
+    switch(config->family){
+        case IIR_BUTTERWORTH:
+            for(uint8_t k=0; k<n; k++){
+                zp->p[k] = -cexp(I * M_PI * (2 * k - n + 1) / (2.0 * n));
+            }
+        break;
+        case IIR_CHEBYSHEV_1:{
+            double eps = sqrt(pow(10, config->ripple / 10.0) - 1);
+            double mu = asinh(1 / eps) / n;
+            for(uint8_t k=0; k<n; k++){
+                zp->p[k] = -csinh(mu + I * M_PI * (2 * k - n + 1) / (2.0 * n));
+            }
+            if(n % 2 == 0){
+                // Even orders start at the bottom of the ripple
+                dc_gain = 1 / sqrt(1 + eps * eps);
+            }
+        }
+        break;
+        case IIR_CHEBYSHEV_2:{
+            double de = 1 / sqrt(pow(10, config->ripple / 10.0) - 1);
+            double mu = asinh(1 / de) / n;
+            for(uint8_t k=0; k<n; k++){
+                int m = 2 * k - n + 1;
+                double complex p = -cexp(I * M_PI * m / (2.0 * n));
+                zp->p[k] = 1 / (sinh(mu) * creal(p) + I * cosh(mu) * cimag(p));
+                if(m != 0){
+                    // Odd orders have a zero at infinity
+                    zp->z[zp->n_z++] = I / sin(m * M_PI / (2.0 * n));
+                }
+            }
+        }
+        break;
+        case IIR_BESSEL:
+            IirBesselPoles(zp->p, n);
+        break;
+    }
+    return dc_gain;
+}
+
+static void IirBesselPoles(double complex * p, uint8_t n){
+    double a[IIR_DESIGN_MAX_ROOTS + 1];
+    // Reverse Bessel polynomial (monic): a[k-1] = a[k] * k * (2n - k + 1) / (2 * (n - k + 1))
+    a[n] = 1;
+    for(uint8_t k=n; k>0; k--){
+        a[k - 1] = a[k] * k * (2 * n - k + 1) / (2.0 * (n - k + 1));
+    }
+    // Durand-Kerner root finding
+    double radius = pow(a[0], 1.0 / n);
+    for(uint8_t k=0; k<n; k++){
+        p[k] = radius * cpow(0.4 + 0.9 * I, k);
+    }
+    for(uint16_t iter=0; iter<IIR_DESIGN_ITERATIONS; iter++){
+        double change = 0;
+        for(uint8_t k=0; k<n; k++){
+            double complex num = 1;
+            double complex den = 1;
+            for(int8_t j=n-1; j>=0; j--){
+                num = num * p[k] + a[j];
+            }
+            for(uint8_t j=0; j<n; j++){
+                if(j != k){
+                    den *= p[k] - p[j];
+                }
+            }
+            double complex delta = num / den;
+            p[k] -= delta;
+            change = fmax(change, cabs(delta) / cabs(p[k]));
+        }
+        if(change < 1e-15){
+            break;
+        }
+    }
+    // Scale to -3 dB at 1 rad/s: |H(jw)|^2 = prod|p|^2 / prod|jw - p|^2 = 1/2
+    double w_low = 0, w_high = 1;
+    for(;;){
+        double mag = 1;
+        for(uint8_t k=0; k<n; k++){
+            mag *= cabs(p[k]) / cabs(I * w_high - p[k]);
+        }
+        if(mag * mag < 0.5){
+            break;
+        }
+        w_high *= 2;
+    }
+    for(uint8_t iter=0; iter<60; iter++){
+        double w = (w_low + w_high) / 2;
+        double mag = 1;
+        for(uint8_t k=0; k<n; k++){
+            mag *= cabs(p[k]) / cabs(I * w - p[k]);
+        }
+        if(mag * mag > 0.5){
+            w_low = w;
+        }
+        else{
+            w_high = w;
+        }
+    }
+    double w_3db = (w_low + w_high) / 2;
+    for(uint8_t k=0; k<n; k++){
+        p[k] /= w_3db;
+    }
+}
+
+static void IirTransform(iir_zp_t * zp, iir_filter_type_t type, double w1, double w2){
+    uint8_t n_p = zp->n_p;
+    uint8_t n_z = zp->n_z;
+    double bw = w2 - w1;
+    double w0 = sqrt(w1 * w2);
+    switch(type){
+        case IIR_LOW_PASS:
+            for(uint8_t k=0; k<n_p; k++){
+                zp->p[k] *= w1;
+            }
+            for(uint8_t k=0; k<n_z; k++){
+                zp->z[k] *= w1;
+            }
+        break;
+        case IIR_HI_PASS:
+            for(uint8_t k=0; k<n_p; k++){
+                zp->p[k] = w1 / zp->p[k];
+            }
+            for(uint8_t k=0; k<n_z; k++){
+                zp->z[k] = w1 / zp->z[k];
+            }
+            // Zeros at infinity move to DC
+            while(zp->n_z < n_p){
+                zp->z[zp->n_z++] = 0;
+            }
+        break;
+        case IIR_BAND_PASS:
+            // s -> (s^2 + w0^2) / (s * bw): each root r gives r*bw/2 +- sqrt((r*bw/2)^2 - w0^2)
+            for(int8_t k=n_p-1; k>=0; k--){
+                double complex r = zp->p[k] * bw / 2;
+                double complex d = csqrt(r * r - w0 * w0);
+                zp->p[2 * k] = r + d;
+                zp->p[2 * k + 1] = r - d;
+            }
+            for(int8_t k=n_z-1; k>=0; k--){
+                double complex r = zp->z[k] * bw / 2;
+                double complex d = csqrt(r * r - w0 * w0);
+                zp->z[2 * k] = r + d;
+                zp->z[2 * k + 1] = r - d;
+            }
+            zp->n_p = 2 * n_p;
+            zp->n_z = 2 * n_z;
+            // Zeros at infinity: half move to DC
+            for(uint8_t k=n_z; k<n_p; k++){
+                zp->z[zp->n_z++] = 0;
+            }
+        break;
+        case IIR_BAND_STOP:
+            // s -> s * bw / (s^2 + w0^2): each root r gives bw/(2r) +- sqrt((bw/(2r))^2 - w0^2)
+            for(int8_t k=n_p-1; k>=0; k--){
+                double complex r = bw / (2 * zp->p[k]);
+                double complex d = csqrt(r * r - w0 * w0);
+                zp->p[2 * k] = r + d;
+                zp->p[2 * k + 1] = r - d;
+            }
+            for(int8_t k=n_z-1; k>=0; k--){
+                double complex r = bw / (2 * zp->z[k]);
+                double complex d = csqrt(r * r - w0 * w0);
+                zp->z[2 * k] = r + d;
+                zp->z[2 * k + 1] = r - d;
+            }
+            zp->n_p = 2 * n_p;
+            zp->n_z = 2 * n_z;
+            // Zeros at infinity move to the band center
+            for(uint8_t k=n_z; k<n_p; k++){
+                zp->z[zp->n_z++] = I * w0;
+                zp->z[zp->n_z++] = -I * w0;
+            }
+        break;
+    }
+}
+
+static void IirBilinear(iir_zp_t * zp){
+    for(uint8_t k=0; k<zp->n_p; k++){
+        zp->p[k] = (2 + zp->p[k]) / (2 - zp->p[k]);
+    }
+    for(uint8_t k=0; k<zp->n_z; k++){
+        zp->z[k] = (2 + zp->z[k]) / (2 - zp->z[k]);
+    }
+    while(zp->n_z < zp->n_p){
+        zp->z[zp->n_z++] = -1;
+    }
+}
+
+/**
+ * @brief Split roots into real ones and complex ones with positive imaginary part
+ * (their conjugates are implied)
+ */
+static void IirSplitRoots(const double complex * roots, uint8_t n, double complex * cplx, uint8_t * n_cplx, double * real, uint8_t * n_real){
+    *n_cplx = 0;
+    *n_real = 0;
+    for(uint8_t k=0; k<n; k++){
+        if(fabs(cimag(roots[k])) <= IIR_DESIGN_REAL_TOL * fmax(1, cabs(roots[k]))){
+            real[(*n_real)++] = creal(roots[k]);
+        }
+        else if(cimag(roots[k]) > 0){
+            cplx[(*n_cplx)++] = roots[k];
+        }
+    }
+}
+
+/**
+ * @brief Index of the real value nearest to x (n > 0)
+ */
+static uint8_t IirNearestReal(const double * real, uint8_t n, double complex x){
+    uint8_t nearest = 0;
+    for(uint8_t k=1; k<n; k++){
+        if(cabs(real[k] - x) < cabs(real[nearest] - x)){
+            nearest = k;
+        }
+    }
+    return nearest;
+}
+
+static uint8_t IirPairSections(iir_zp_t * zp, float * coeff){
+    double complex p_cplx[IIR_DESIGN_MAX_ROOTS], z_cplx[IIR_DESIGN_MAX_ROOTS];
+    double p_real[IIR_DESIGN_MAX_ROOTS], z_real[IIR_DESIGN_MAX_ROOTS];
+    uint8_t n_p_cplx, n_p_real, n_z_cplx, n_z_real;
+    IirSplitRoots(zp->p, zp->n_p, p_cplx, &n_p_cplx, p_real, &n_p_real);
+    IirSplitRoots(zp->z, zp->n_z, z_cplx, &n_z_cplx, z_real, &n_z_real);
+    uint8_t n_sos = n_p_cplx + (n_p_real + 1) / 2;
+    // Closest poles to the unit circle first, stored from the last section backwards
+    for(int8_t sos=n_sos-1; sos>=0; sos--){
+        float * c = &coeff[sos * IIR_SOS_COEFF];
+        double complex p1;
+        bool p1_cplx = false;
+        uint8_t idx = 0;
+        double radius = -1;
+        for(uint8_t k=0; k<n_p_cplx; k++){
+            if(cabs(p_cplx[k]) > radius){
+                radius = cabs(p_cplx[k]);
+                idx = k;
+                p1_cplx = true;
+            }
+        }
+        for(uint8_t k=0; k<n_p_real; k++){
+            if(fabs(p_real[k]) > radius){
+                radius = fabs(p_real[k]);
+                idx = k;
+                p1_cplx = false;
+            }
+        }
+        // Poles of the section
+        bool second_order = true;
+        if(p1_cplx){
+            p1 = p_cplx[idx];
+            p_cplx[idx] = p_cplx[--n_p_cplx];
+            c[3] = -2 * creal(p1);
+            c[4] = creal(p1) * creal(p1) + cimag(p1) * cimag(p1);
+        }
+        else{
+            p1 = p_real[idx];
+            p_real[idx] = p_real[--n_p_real];
+            if(n_p_real > 0){
+                uint8_t j = IirNearestReal(p_real, n_p_real, p1);
+                double p2 = p_real[j];
+                p_real[j] = p_real[--n_p_real];
+                c[3] = -(creal(p1) + p2);
+                c[4] = creal(p1) * p2;
+            }
+            else{
+                second_order = false;
+                c[3] = -creal(p1);
+                c[4] = 0;
+            }
+        }
+        // Zeros nearest to the first pole
+        if(second_order){
+            bool use_cplx = (n_z_real < 2);
+            uint8_t zc = 0;
+            for(uint8_t k=1; k<n_z_cplx; k++){
+                if(cabs(z_cplx[k] - p1) < cabs(z_cplx[zc] - p1)){
+                    zc = k;
+                }
+            }
+            if((!use_cplx) && (n_z_cplx > 0)){
+                uint8_t zr = IirNearestReal(z_real, n_z_real, p1);
+                use_cplx = cabs(z_cplx[zc] - p1) < cabs(z_real[zr] - p1);
+            }
+            if(use_cplx){
+                double complex z1 = z_cplx[zc];
+                z_cplx[zc] = z_cplx[--n_z_cplx];
+                c[1] = -2 * creal(z1);
+                c[2] = creal(z1) * creal(z1) + cimag(z1) * cimag(z1);
+            }
+            else{
+                uint8_t j = IirNearestReal(z_real, n_z_real, p1);
+                double z1 = z_real[j];
+                z_real[j] = z_real[--n_z_real];
+                j = IirNearestReal(z_real, n_z_real, p1);
+                double z2 = z_real[j];
+                z_real[j] = z_real[--n_z_real];
+                c[1] = -(z1 + z2);
+                c[2] = z1 * z2;
+            }
+        }
+        else{
+            uint8_t j = IirNearestReal(z_real, n_z_real, p1);
+            c[1] = -z_real[j];
+            c[2] = 0;
+            z_real[j] = z_real[--n_z_real];
+        }
+        c[0] = 1;
+    }
+    return n_sos;
+}
+
+static void IirSectionGain(float * coeff, double w_ref, double gain){
+    double complex z1 = cexp(-I * w_ref);
+    double complex z2 = z1 * z1;
+    double complex num = coeff[0] + coeff[1] * z1 + coeff[2] * z2;
+    double complex den = 1 + coeff[3] * z1 + coeff[4] * z2;
+    double scale = gain / cabs(num / den);
+    for(uint8_t k=0; k<3; k++){
+        coeff[k] *= scale;
+    }
+}
+
+/*==================[external functions definition]==========================*/
+bool IirDesign(iir_filter_t * filter, iir_design_config_t * config){
+    memset(filter, 0, sizeof(iir_filter_t));
+    bool band = (config->type == IIR_BAND_PASS) || (config->type == IIR_BAND_STOP);
+    uint8_t max_order = band ? IIR_MAX_SOS : 2 * IIR_MAX_SOS;
+    if((config->order == 0) || (config->order > max_order)){
+        ESP_LOGE(TAG, "Invalid filter order: %d", config->order);
+        return false;
+    }
+    double f1 = config->cut_frec / config->sample_frec;
+    double f2 = band ? (config->cut_frec_high / config->sample_frec) : f1;
+    if((f1 <= 0) || (f2 >= 0.5) || (f2 < f1) || (band && (f2 == f1))){
+        ESP_LOGE(TAG, "Invalid cut-off frequency: %.2f Hz - %.2f Hz", config->cut_frec, config->cut_frec_high);
+        return false;
+    }
+    if(((config->family == IIR_CHEBYSHEV_1) || (config->family == IIR_CHEBYSHEV_2)) && (config->ripple <= 0)){
+        ESP_LOGE(TAG, "Invalid ripple: %.2f dB", config->ripple);
+        return false;
+    }
+    if(config->family > IIR_BESSEL){
+        ESP_LOGE(TAG, "Invalid filter family: %d", config->family);
+        return false;
+    }
+    iir_zp_t zp;
+    double gain = IirPrototype(&zp, config);
+    // Pre-warped edges (bilinear transform with s = 2 (z - 1) / (z + 1))
+    double w1 = 2 * tan(M_PI * f1);
+    double w2 = 2 * tan(M_PI * f2);
+    IirTransform(&zp, config->type, w1, w2);
+    IirBilinear(&zp);
+    filter->n_sos = IirPairSections(&zp, filter->coeff);
+    // Pass band reference: prototype DC maps to DC, Nyquist or band center
+    double w_ref = 0;
+    if(config->type == IIR_HI_PASS){
+        w_ref = M_PI;
+    }
+    else if(config->type == IIR_BAND_PASS){
+        w_ref = 2 * atan(sqrt(w1 * w2) / 2);
+    }
+    for(uint8_t i=0; i<filter->n_sos; i++){
+        // Overall gain (Chebyshev I ripple) on the first section
+        IirSectionGain(&filter->coeff[i * IIR_SOS_COEFF], w_ref, (i == 0) ? gain : 1);
+    }
+    return true;
+}
+
+/*==================[end of file]============================================*/
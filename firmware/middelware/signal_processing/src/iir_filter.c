@@ -10,11 +10,18 @@
  */
 
 /*==================[inclusions]=============================================*/
+#include <string.h>
 #include "iir_filter.h"
 #include "esp_dsp.h"
+#include "esp_log.h"
 /*==================[macros and definitions]=================================*/
-#define N_SOS       5
-#define N_DELAY     2
+#define TAG "IIR Module"
+#define IIR_FUSED_SOS   4       /*!< Sections filtered in one pass over the signal (state kept in registers) */
+#define IIR_FILTFILT_MAX_PAD (3 * (2 * IIR_MAX_SOS + 1))  /*!< Maximum extension at each end of IirFiltFilt() windows */
+#define IIR_MULTI_FUSED_SOS 2   /*!< Sections filtered in one pass over the signals (1 or 2 channels) */
+#define IIR_SWAP_ACTIVE     0x01    /*!< swap_state: index of the active filter */
+#define IIR_SWAP_LOADED     0x02    /*!< swap_state: standby filter loaded, not used yet */
+#define IIR_SWAP_FADING     0x04    /*!< swap_state: standby filter (previous) in use by a cross-fade */
 // 2nd order Butterworth 
 #define ORDER2_Q    (1 / 1.414)
 // 4th order Butterworth 
@@ -30,127 +37,537 @@
 #define ORDER8_Q3   (1 / 1.663)
 #define ORDER8_Q4   (1 / 1.962)
 /*==================[internal data declaration]==============================*/
-static uint8_t lp_order, hp_order;
-float hp2_delay[N_DELAY] = {0, 0};  // delay
-float hp4_delay[N_DELAY] = {0, 0};  // delay
-float hp6_delay[N_DELAY] = {0, 0};  // delay
-float hp8_delay[N_DELAY] = {0, 0};  // delay
-float lp2_delay[N_DELAY] = {0, 0};  // delay
-float lp4_delay[N_DELAY] = {0, 0};  // delay
-float lp6_delay[N_DELAY] = {0, 0};  // delay
-float lp8_delay[N_DELAY] = {0, 0};  // delay
-float lp2_sos_coeff[N_SOS]; 
-float lp4_sos_coeff[N_SOS]; 
-float lp6_sos_coeff[N_SOS]; 
-float lp8_sos_coeff[N_SOS]; 
-float hp2_sos_coeff[N_SOS]; 
-float hp4_sos_coeff[N_SOS]; 
-float hp6_sos_coeff[N_SOS]; 
-float hp8_sos_coeff[N_SOS]; 
+static iir_swap_t lp_filter;        /*!< Filter used by LowPassInit() / LowPassFilter() */
+static iir_swap_t hp_filter;        /*!< Filter used by HiPassInit() / HiPassFilter() */
 /*==================[internal functions declaration]=========================*/
+/**
+ * @brief Filter a signal through a cascade of sections, each sample through up to
+ * IIR_FUSED_SOS sections per pass
+ * 
+ * @note Same operations and order as dsps_biquad_f32_ansi(), so results are bit identical
+ * to filtering the whole signal section by section
+ * 
+ * @param coeff             Coefficients of each section (b0, b1, b2, a1, a2)
+ * @param delay             Delay line of each section
+ * @param n_sos             Number of sections (max 2 * IIR_MAX_SOS)
+ * @param input_signal      Input signal array
+ * @param output_signal     Filtered signal array (can be the same as input_signal)
+ * @param signal_lenght     Number of samples of both signals
+ */
+static void IirCascade(const float * coeff, float * delay, uint8_t n_sos, const float * input_signal, float * output_signal, int16_t signal_lenght);
 
-/*==================[internal data definition]===============================*/
+/**
+ * @brief Filter all channels of a multi-channel filter, up to IIR_MULTI_FUSED_SOS sections per pass
+ * 
+ * Sample i of channel ch is input_signals[ch][i * step] (interleaved signals: step is the
+ * number of channels, one array per channel: step is 1).
+ * 
+ * @param multi             Pointer to multi-channel filter
+ * @param input_signals     Pointer to first sample of each channel's input
+ * @param output_signals    Pointer to first sample of each channel's output
+ * @param step              Distance between samples of a channel
+ * @param signal_lenght     Number of samples of each channel
+ */
+static void IirMultiCascade(iir_multi_t * multi, float * const * input_signals, float * const * output_signals, uint8_t step, int16_t signal_lenght);
 
+/**
+ * @brief Set the delay lines to the steady state of a constant input (as scipy.signal.sosfilt_zi())
+ * 
+ * @param coeff             Coefficients of each section (b0, b1, b2, a1, a2)
+ * @param delay             Delay line of each section
+ * @param n_sos             Number of sections
+ * @param value             Constant input value
+ */
+static void IirSteadyState(const float * coeff, float * delay, uint8_t n_sos, float value);
+
+/**
+ * @brief Reverse the order of the samples of a signal
+ */
+static void IirReverse(float * signal, int16_t signal_lenght);
+
+/**
+ * @brief Set the state of a filter that replaces another one
+ * 
+ * @param swap              Pointer to hot-swappable filter
+ * @param previous          Filter replaced (only its delay lines are used)
+ * @param next              New active filter
+ */
+static void IirSwapStart(iir_swap_t * swap, const iir_filter_t * previous, iir_filter_t * next);
+
+/**
+ * @brief Initialize or change the filter of LowPassInit() / HiPassInit()
+ */
+static void IirSwapConfig(iir_swap_t * swap, iir_filter_config_t * config);
+/*==================[internal data definition]===============================*/
+static const float order2_q[] = {ORDER2_Q};
+static const float order4_q[] = {ORDER4_Q1, ORDER4_Q2};
+static const float order6_q[] = {ORDER6_Q1, ORDER6_Q2, ORDER6_Q3};
+static const float order8_q[] = {ORDER8_Q1, ORDER8_Q2, ORDER8_Q3, ORDER8_Q4};
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief One sample through one section (same operations as dsps_biquad_f32_ansi())
+ */
+static inline __attribute__((always_inline)) float IirSection(float x, const float * c, float * w0, float * w1){
+    float d0 = x - c[3] * *w0 - c[4] * *w1;
+    float y = c[0] * d0 + c[1] * *w0 + c[2] * *w1;
+    *w1 = *w0;
+    *w0 = d0;
+    return y;
+}
 
-/*==================[external functions definition]==========================*/
+/**
+ * @brief Cascade kernel of up to IIR_FUSED_SOS sections, inlined with constant n_sos so the
+ * state of every section is kept in registers
+ */
+static inline __attribute__((always_inline)) void IirCascadeN(const float * coeff, float * delay, const uint8_t n_sos, const float * input_signal, float * output_signal, int16_t signal_lenght){
+    float c[IIR_FUSED_SOS * IIR_SOS_COEFF];
+    float w[IIR_FUSED_SOS * IIR_SOS_DELAY] = {0};
+    // Local copies: not aliased by output_signal
+    memcpy(c, coeff, n_sos * IIR_SOS_COEFF * sizeof(float));
+    memcpy(w, delay, n_sos * IIR_SOS_DELAY * sizeof(float));
+    float w00 = w[0], w01 = w[1], w10 = w[2], w11 = w[3];
+    float w20 = w[4], w21 = w[5], w30 = w[6], w31 = w[7];
+    for(int16_t i=0; i<signal_lenght; i++){
+        float x = input_signal[i];
+        x = IirSection(x, &c[0 * IIR_SOS_COEFF], &w00, &w01);
+        if(n_sos > 1){
+            x = IirSection(x, &c[1 * IIR_SOS_COEFF], &w10, &w11);
+        }
+        if(n_sos > 2){
+            x = IirSection(x, &c[2 * IIR_SOS_COEFF], &w20, &w21);
+        }
+        if(n_sos > 3){
+            x = IirSection(x, &c[3 * IIR_SOS_COEFF], &w30, &w31);
+        }
+        output_signal[i] = x;
+    }
+    w[0] = w00; w[1] = w01; w[2] = w10; w[3] = w11;
+    w[4] = w20; w[5] = w21; w[6] = w30; w[7] = w31;
+    memcpy(delay, w, n_sos * IIR_SOS_DELAY * sizeof(float));
+}
 
-void LowPassInit(float sample_frec, float cut_frec, filter_order_t order){
-    float f = cut_frec / sample_frec;
-    lp_order = order;
-    switch(lp_order){
-        case ORDER_2:
-            dsps_biquad_gen_lpf_f32(lp2_sos_coeff, f, ORDER2_Q);
-        break;
-        case ORDER_4:
-            dsps_biquad_gen_lpf_f32(lp2_sos_coeff, f, ORDER4_Q1);
-            dsps_biquad_gen_lpf_f32(lp4_sos_coeff, f, ORDER4_Q2);
-        break;
-        case ORDER_6:
-            dsps_biquad_gen_lpf_f32(lp2_sos_coeff, f, ORDER6_Q1);
-            dsps_biquad_gen_lpf_f32(lp4_sos_coeff, f, ORDER6_Q2);
-            dsps_biquad_gen_lpf_f32(lp6_sos_coeff, f, ORDER6_Q3);
-        break;
-        case ORDER_8:
-            dsps_biquad_gen_lpf_f32(lp2_sos_coeff, f, ORDER8_Q1);
-            dsps_biquad_gen_lpf_f32(lp4_sos_coeff, f, ORDER8_Q2);
-            dsps_biquad_gen_lpf_f32(lp6_sos_coeff, f, ORDER8_Q3);
-            dsps_biquad_gen_lpf_f32(lp8_sos_coeff, f, ORDER8_Q4);
-        break;
+static void IirCascade(const float * coeff, float * delay, uint8_t n_sos, const float * input_signal, float * output_signal, int16_t signal_lenght){
+    if((n_sos == 0) && (output_signal != input_signal)){
+        memmove(output_signal, input_signal, signal_lenght * sizeof(float));
+    }
+    // Up to IIR_FUSED_SOS sections (8th order) per pass over the signal
+    while(n_sos > 0){
+        uint8_t n = (n_sos > IIR_FUSED_SOS) ? IIR_FUSED_SOS : n_sos;
+        switch(n){
+            case 1:
+                IirCascadeN(coeff, delay, 1, input_signal, output_signal, signal_lenght);
+            break;
+            case 2:
+                IirCascadeN(coeff, delay, 2, input_signal, output_signal, signal_lenght);
+            break;
+            case 3:
+                IirCascadeN(coeff, delay, 3, input_signal, output_signal, signal_lenght);
+            break;
+            default:
+                IirCascadeN(coeff, delay, 4, input_signal, output_signal, signal_lenght);
+            break;
+        }
+        coeff += n * IIR_SOS_COEFF;
+        delay += n * IIR_SOS_DELAY;
+        n_sos -= n;
+        input_signal = output_signal;
     }
 }
 
-void HiPassInit(float sample_frec, float cut_frec, filter_order_t order){
-    float f = cut_frec / sample_frec;
-    hp_order = order;
-    switch(hp_order){
-        case ORDER_2:
-            dsps_biquad_gen_hpf_f32(hp2_sos_coeff, f, ORDER2_Q);
-        break;
-        case ORDER_4:
-            dsps_biquad_gen_hpf_f32(hp2_sos_coeff, f, ORDER4_Q1);
-            dsps_biquad_gen_hpf_f32(hp4_sos_coeff, f, ORDER4_Q2);
-        break;
-        case ORDER_6:
-            dsps_biquad_gen_hpf_f32(hp2_sos_coeff, f, ORDER6_Q1);
-            dsps_biquad_gen_hpf_f32(hp4_sos_coeff, f, ORDER6_Q2);
-            dsps_biquad_gen_hpf_f32(hp6_sos_coeff, f, ORDER6_Q3);
-        break;
-        case ORDER_8:
-            dsps_biquad_gen_hpf_f32(hp2_sos_coeff, f, ORDER8_Q1);
-            dsps_biquad_gen_hpf_f32(hp4_sos_coeff, f, ORDER8_Q2);
-            dsps_biquad_gen_hpf_f32(hp6_sos_coeff, f, ORDER8_Q3);
-            dsps_biquad_gen_hpf_f32(hp8_sos_coeff, f, ORDER8_Q4);
-        break;
+/**
+ * @brief n_sec sections of n_ch channels, inlined with constant n_sec and n_ch so the
+ * state of every channel is kept in registers and the channel recurrences are interleaved
+ */
+static inline __attribute__((always_inline)) void IirMultiSections(const float * coeff, uint16_t coeff_step, float * delay, const uint8_t n_sec, const uint8_t n_ch, float * const * input_signals, float * const * output_signals, uint8_t step, int16_t signal_lenght){
+    float c[IIR_MAX_CHANNELS][IIR_MULTI_FUSED_SOS][IIR_SOS_COEFF];
+    float w0[IIR_MAX_CHANNELS][IIR_MULTI_FUSED_SOS], w1[IIR_MAX_CHANNELS][IIR_MULTI_FUSED_SOS];
+    const float * in[IIR_MAX_CHANNELS];
+    float * out[IIR_MAX_CHANNELS];
+    #pragma GCC unroll 4
+    for(uint8_t ch=0; ch<n_ch; ch++){
+        #pragma GCC unroll 2
+        for(uint8_t sec=0; sec<n_sec; sec++){
+            memcpy(c[ch][sec], &coeff[ch * coeff_step + sec * IIR_SOS_COEFF], IIR_SOS_COEFF * sizeof(float));
+            w0[ch][sec] = delay[(ch * IIR_MAX_SOS + sec) * IIR_SOS_DELAY];
+            w1[ch][sec] = delay[(ch * IIR_MAX_SOS + sec) * IIR_SOS_DELAY + 1];
+        }
+        in[ch] = input_signals[ch];
+        out[ch] = output_signals[ch];
+    }
+    for(int16_t i=0; i<signal_lenght; i++){
+        // Same operations as dsps_biquad_f32_ansi() on each channel
+        #pragma GCC unroll 4
+        for(uint8_t ch=0; ch<n_ch; ch++){
+            float x = in[ch][i * step];
+            #pragma GCC unroll 2
+            for(uint8_t sec=0; sec<n_sec; sec++){
+                float d0 = x - c[ch][sec][3] * w0[ch][sec] - c[ch][sec][4] * w1[ch][sec];
+                x = c[ch][sec][0] * d0 + c[ch][sec][1] * w0[ch][sec] + c[ch][sec][2] * w1[ch][sec];
+                w1[ch][sec] = w0[ch][sec];
+                w0[ch][sec] = d0;
+            }
+            out[ch][i * step] = x;
+        }
+    }
+    #pragma GCC unroll 4
+    for(uint8_t ch=0; ch<n_ch; ch++){
+        #pragma GCC unroll 2
+        for(uint8_t sec=0; sec<n_sec; sec++){
+            delay[(ch * IIR_MAX_SOS + sec) * IIR_SOS_DELAY] = w0[ch][sec];
+            delay[(ch * IIR_MAX_SOS + sec) * IIR_SOS_DELAY + 1] = w1[ch][sec];
+        }
     }
 }
 
-void LowPassFilter(float * input_signal, float * output_signal, int16_t signal_lenght){
-    switch(lp_order){
-        case ORDER_2:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, lp2_sos_coeff, lp2_delay);
-        break;
-        case ORDER_4:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, lp2_sos_coeff, lp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp4_sos_coeff, lp4_delay);
+/**
+ * @brief IirMultiSections() with constant number of channels (2 to IIR_MAX_CHANNELS)
+ */
+static inline __attribute__((always_inline)) void IirMultiChannels(const float * coeff, uint16_t coeff_step, float * delay, const uint8_t n_sec, uint8_t n_ch, float * const * input_signals, float * const * output_signals, uint8_t step, int16_t signal_lenght){
+    switch(n_ch){
+        case 2:
+            IirMultiSections(coeff, coeff_step, delay, n_sec, 2, input_signals, output_signals, step, signal_lenght);
         break;
-        case ORDER_6:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, lp2_sos_coeff, lp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp4_sos_coeff, lp4_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp6_sos_coeff, lp6_delay);
+        case 3:
+            IirMultiSections(coeff, coeff_step, delay, n_sec, 3, input_signals, output_signals, step, signal_lenght);
         break;
-        case ORDER_8:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, lp2_sos_coeff, lp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp4_sos_coeff, lp4_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp6_sos_coeff, lp6_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp8_sos_coeff, lp8_delay);
+        default:
+            IirMultiSections(coeff, coeff_step, delay, n_sec, 4, input_signals, output_signals, step, signal_lenght);
         break;
     }
 }
 
+static void IirMultiCascade(iir_multi_t * multi, float * const * input_signals, float * const * output_signals, uint8_t step, int16_t signal_lenght){
+    if(multi->n_channels == 1){
+        // Same layout as iir_filter_t for channel 0
+        IirCascade(multi->coeff, multi->delay, multi->n_sos, input_signals[0], output_signals[0], signal_lenght);
+        return;
+    }
+    uint16_t coeff_step = multi->shared ? 0 : (IIR_MAX_SOS * IIR_SOS_COEFF);
+    // More than 2 channels: one section per pass, so all states still fit in registers
+    uint8_t fused = (multi->n_channels > 2) ? 1 : IIR_MULTI_FUSED_SOS;
+    for(uint8_t sos=0; sos<multi->n_sos; sos+=fused){
+        const float * coeff = &multi->coeff[sos * IIR_SOS_COEFF];
+        float * delay = &multi->delay[sos * IIR_SOS_DELAY];
+        if((fused == 1) || (multi->n_sos - sos == 1)){
+            IirMultiChannels(coeff, coeff_step, delay, 1, multi->n_channels, input_signals, output_signals, step, signal_lenght);
+        }
+        else{
+            IirMultiChannels(coeff, coeff_step, delay, 2, multi->n_channels, input_signals, output_signals, step, signal_lenght);
+        }
+        // Next sections filter the output in place
+        input_signals = output_signals;
+    }
+}
+
+static void IirSteadyState(const float * coeff, float * delay, uint8_t n_sos, float value){
+    for(uint8_t i=0; i<n_sos; i++){
+        const float * c = &coeff[i * IIR_SOS_COEFF];
+        // Direct form II: w0 = w1 = d = value / (1 + a1 + a2)
+        float d = value / (1 + c[3] + c[4]);
+        delay[i * IIR_SOS_DELAY] = d;
+        delay[i * IIR_SOS_DELAY + 1] = d;
+        // Input of next section
+        value = (c[0] + c[1] + c[2]) * d;
+    }
+}
+
+static void IirReverse(float * signal, int16_t signal_lenght){
+    for(int16_t i=0, j=signal_lenght-1; i<j; i++, j--){
+        float aux = signal[i];
+        signal[i] = signal[j];
+        signal[j] = aux;
+    }
+}
+
+static void IirSwapStart(iir_swap_t * swap, const iir_filter_t * previous, iir_filter_t * next){
+    if(swap->mode == IIR_SWAP_KEEP_STATE){
+        // Delay lines beyond n_sos are always zero: new sections start from rest
+        memcpy(next->delay, previous->delay, sizeof(next->delay));
+        memset(&next->delay[next->n_sos * IIR_SOS_DELAY], 0, (IIR_MAX_SOS - next->n_sos) * IIR_SOS_DELAY * sizeof(float));
+    }
+    else{
+        memset(next->delay, 0, sizeof(next->delay));
+        IirSteadyState(next->coeff, next->delay, next->n_sos, swap->last_sample);
+    }
+    swap->fade_pos = 0;
+}
+
+static void IirSwapConfig(iir_swap_t * swap, iir_filter_config_t * config){
+    iir_filter_t filter;
+    IirInit(&filter, config);
+    if((swap->bank[0].n_sos == 0) && (swap->bank[1].n_sos == 0)){
+        IirSwapInit(swap, &filter, IIR_SWAP_STEADY_STATE, 0);
+    }
+    else{
+        // Never fails without cross-fade
+        IirSwapLoad(swap, &filter);
+    }
+}
+
+/*==================[external functions definition]==========================*/
+
+void LowPassInit(float sample_frec, float cut_frec, filter_order_t order){
+    iir_filter_config_t config = {
+        .type = IIR_LOW_PASS,
+        .sample_frec = sample_frec,
+        .cut_frec = cut_frec,
+        .order = order
+    };
+    IirSwapConfig(&lp_filter, &config);
+}
+
+void HiPassInit(float sample_frec, float cut_frec, filter_order_t order){
+    iir_filter_config_t config = {
+        .type = IIR_HI_PASS,
+        .sample_frec = sample_frec,
+        .cut_frec = cut_frec,
+        .order = order
+    };
+    IirSwapConfig(&hp_filter, &config);
+}
+
+void LowPassFilter(float * input_signal, float * output_signal, int16_t signal_lenght){
+    IirSwapFilter(&lp_filter, input_signal, output_signal, signal_lenght);
+}
+
 void HiPassFilter(float * input_signal, float * output_signal, int16_t signal_lenght){
-    switch(hp_order){
+    IirSwapFilter(&hp_filter, input_signal, output_signal, signal_lenght);
+}
+
+bool IirInit(iir_filter_t * filter, iir_filter_config_t * config){
+    memset(filter, 0, sizeof(iir_filter_t));
+    if((config->type != IIR_LOW_PASS) && (config->type != IIR_HI_PASS)){
+        ESP_LOGE(TAG, "Invalid filter type: %d (use IirDesign())", config->type);
+        return false;
+    }
+    float f = config->cut_frec / config->sample_frec;
+    if((f <= 0) || (f >= 0.5)){
+        ESP_LOGE(TAG, "Invalid cut-off frequency: %.2f Hz", config->cut_frec);
+        return false;
+    }
+    const float * q;
+    switch(config->order){
         case ORDER_2:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, hp2_sos_coeff, hp2_delay);
+            q = order2_q;
         break;
         case ORDER_4:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, hp2_sos_coeff, hp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp4_sos_coeff, hp4_delay);
+            q = order4_q;
         break;
         case ORDER_6:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, hp2_sos_coeff, hp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp4_sos_coeff, hp4_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp6_sos_coeff, hp6_delay);
+            q = order6_q;
         break;
         case ORDER_8:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, hp2_sos_coeff, hp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp4_sos_coeff, hp4_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp6_sos_coeff, hp6_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp8_sos_coeff, hp8_delay);
+            q = order8_q;
         break;
+        default:
+            ESP_LOGE(TAG, "Invalid filter order: %d", config->order);
+            return false;
+    }
+    filter->n_sos = config->order / 2;
+    for(uint8_t i=0; i<filter->n_sos; i++){
+        if(config->type == IIR_LOW_PASS){
+            dsps_biquad_gen_lpf_f32(&filter->coeff[i * IIR_SOS_COEFF], f, q[i]);
+        }
+        else{
+            dsps_biquad_gen_hpf_f32(&filter->coeff[i * IIR_SOS_COEFF], f, q[i]);
+        }
+    }
+    return true;
+}
+
+bool IirLoad(iir_filter_t * filter, const float * coeff, uint8_t n_sos){
+    memset(filter, 0, sizeof(iir_filter_t));
+    if((n_sos == 0) || (n_sos > IIR_MAX_SOS)){
+        ESP_LOGE(TAG, "Invalid number of sections: %d", n_sos);
+        return false;
+    }
+    filter->n_sos = n_sos;
+    memcpy(filter->coeff, coeff, n_sos * IIR_SOS_COEFF * sizeof(float));
+    return true;
+}
+
+void IirFilter(iir_filter_t * filter, float * input_signal, float * output_signal, int16_t signal_lenght){
+    if(signal_lenght == 1){
+        // Sample by sample filtering (e.g. HiPassFilter(&x, &y, 1))
+        *output_signal = IirStep(filter, *input_signal);
+        return;
+    }
+    IirCascade(filter->coeff, filter->delay, filter->n_sos, input_signal, output_signal, signal_lenght);
+}
+
+void IirFilterChain(iir_filter_t * first, iir_filter_t * second, float * input_signal, float * output_signal, int16_t signal_lenght){
+    float coeff[2 * IIR_MAX_SOS * IIR_SOS_COEFF];
+    float delay[2 * IIR_MAX_SOS * IIR_SOS_DELAY];
+    uint8_t n1 = first->n_sos;
+    uint8_t n2 = second->n_sos;
+    // Both cascades as one
+    memcpy(coeff, first->coeff, n1 * IIR_SOS_COEFF * sizeof(float));
+    memcpy(&coeff[n1 * IIR_SOS_COEFF], second->coeff, n2 * IIR_SOS_COEFF * sizeof(float));
+    memcpy(delay, first->delay, n1 * IIR_SOS_DELAY * sizeof(float));
+    memcpy(&delay[n1 * IIR_SOS_DELAY], second->delay, n2 * IIR_SOS_DELAY * sizeof(float));
+    IirCascade(coeff, delay, n1 + n2, input_signal, output_signal, signal_lenght);
+    memcpy(first->delay, delay, n1 * IIR_SOS_DELAY * sizeof(float));
+    memcpy(second->delay, &delay[n1 * IIR_SOS_DELAY], n2 * IIR_SOS_DELAY * sizeof(float));
+}
+
+void IirReset(iir_filter_t * filter){
+    memset(filter->delay, 0, sizeof(filter->delay));
+}
+
+void IirFiltFilt(iir_filter_t * filter, float * signal, int16_t signal_lenght){
+    float delay[IIR_MAX_SOS * IIR_SOS_DELAY];
+    float pad[IIR_FILTFILT_MAX_PAD];
+    if(signal_lenght < 2){
+        return;
+    }
+    // Extension lenght as scipy.signal.sosfiltfilt(): 3 * number of taps
+    uint8_t b2_zero = 0, a2_zero = 0;
+    for(uint8_t i=0; i<filter->n_sos; i++){
+        b2_zero += (filter->coeff[i * IIR_SOS_COEFF + 2] == 0);
+        a2_zero += (filter->coeff[i * IIR_SOS_COEFF + 4] == 0);
+    }
+    int16_t n_pad = 3 * (2 * filter->n_sos + 1 - ((b2_zero < a2_zero) ? b2_zero : a2_zero));
+    if(n_pad >= signal_lenght){
+        n_pad = signal_lenght - 1;
+    }
+    float first = signal[0];
+    float last = signal[signal_lenght - 1];
+    // Forward: left extension (output discarded), signal and right extension
+    for(int16_t i=0; i<n_pad; i++){
+        pad[i] = 2 * first - signal[n_pad - i];
+    }
+    IirSteadyState(filter->coeff, delay, filter->n_sos, 2 * first - signal[n_pad]);
+    IirCascade(filter->coeff, delay, filter->n_sos, pad, pad, n_pad);
+    for(int16_t i=0; i<n_pad; i++){
+        pad[i] = 2 * last - signal[signal_lenght - 2 - i];
+    }
+    IirCascade(filter->coeff, delay, filter->n_sos, signal, signal, signal_lenght);
+    IirCascade(filter->coeff, delay, filter->n_sos, pad, pad, n_pad);
+    // Backward: right extension and signal (left extension not needed)
+    IirReverse(pad, n_pad);
+    IirReverse(signal, signal_lenght);
+    IirSteadyState(filter->coeff, delay, filter->n_sos, pad[0]);
+    IirCascade(filter->coeff, delay, filter->n_sos, pad, pad, n_pad);
+    IirCascade(filter->coeff, delay, filter->n_sos, signal, signal, signal_lenght);
+    IirReverse(signal, signal_lenght);
+}
+
+bool IirMultiInit(iir_multi_t * multi, const iir_filter_t * filters, uint8_t n_filters, uint8_t n_channels){
+    memset(multi, 0, sizeof(iir_multi_t));
+    if((n_channels == 0) || (n_channels > IIR_MAX_CHANNELS)){
+        ESP_LOGE(TAG, "Invalid number of channels: %d", n_channels);
+        return false;
+    }
+    if((n_filters != 1) && (n_filters != n_channels)){
+        ESP_LOGE(TAG, "Invalid number of filters: %d", n_filters);
+        return false;
+    }
+    multi->n_channels = n_channels;
+    multi->shared = (n_filters == 1);
+    for(uint8_t i=0; i<n_filters; i++){
+        if(filters[i].n_sos > multi->n_sos){
+            multi->n_sos = filters[i].n_sos;
+        }
+    }
+    if(multi->n_sos == 0){
+        ESP_LOGE(TAG, "Filters not initialized");
+        return false;
+    }
+    for(uint8_t i=0; i<n_filters; i++){
+        float * coeff = &multi->coeff[i * IIR_MAX_SOS * IIR_SOS_COEFF];
+        memcpy(coeff, filters[i].coeff, filters[i].n_sos * IIR_SOS_COEFF * sizeof(float));
+        for(uint8_t sos=filters[i].n_sos; sos<multi->n_sos; sos++){
+            // Pass-through section
+            coeff[sos * IIR_SOS_COEFF] = 1;
+        }
+    }
+    return true;
+}
+
+void IirMultiFilter(iir_multi_t * multi, float * input_signal, float * output_signal, int16_t signal_lenght){
+    float * input_signals[IIR_MAX_CHANNELS];
+    float * output_signals[IIR_MAX_CHANNELS];
+    for(uint8_t ch=0; ch<multi->n_channels; ch++){
+        input_signals[ch] = &input_signal[ch];
+        output_signals[ch] = &output_signal[ch];
+    }
+    IirMultiCascade(multi, input_signals, output_signals, multi->n_channels, signal_lenght);
+}
+
+void IirMultiFilterSoA(iir_multi_t * multi, float ** input_signals, float ** output_signals, int16_t signal_lenght){
+    IirMultiCascade(multi, input_signals, output_signals, 1, signal_lenght);
+}
+
+void IirMultiReset(iir_multi_t * multi){
+    memset(multi->delay, 0, sizeof(multi->delay));
+}
+
+void IirSwapInit(iir_swap_t * swap, const iir_filter_t * filter, iir_swap_mode_t mode, uint16_t fade_lenght){
+    memset(swap, 0, sizeof(iir_swap_t));
+    swap->bank[0].n_sos = filter->n_sos;
+    memcpy(swap->bank[0].coeff, filter->coeff, sizeof(filter->coeff));
+    swap->mode = mode;
+    swap->fade_lenght = (mode == IIR_SWAP_CROSSFADE) ? fade_lenght : 0;
+}
+
+bool IirSwapLoad(iir_swap_t * swap, const iir_filter_t * filter){
+    uint32_t state = __atomic_load_n(&swap->swap_state, __ATOMIC_ACQUIRE);
+    // Take back coefficients loaded and not used yet (fails if IirSwapFilter() just took them)
+    while((state & IIR_SWAP_LOADED) &&
+          !__atomic_compare_exchange_n(&swap->swap_state, &state, state & ~IIR_SWAP_LOADED, false, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)){
+    }
+    if(state & IIR_SWAP_FADING){
+        return false;
+    }
+    state &= IIR_SWAP_ACTIVE;
+    // Only coefficients: delay lines of the standby filter are read by IirSwapStart()
+    iir_filter_t * standby = &swap->bank[state ^ IIR_SWAP_ACTIVE];
+    standby->n_sos = filter->n_sos;
+    memcpy(standby->coeff, filter->coeff, sizeof(filter->coeff));
+    __atomic_store_n(&swap->swap_state, state | IIR_SWAP_LOADED, __ATOMIC_RELEASE);
+    return true;
+}
+
+void IirSwapFilter(iir_swap_t * swap, float * input_signal, float * output_signal, int16_t signal_lenght){
+    if(signal_lenght <= 0){
+        return;
+    }
+    float last_sample = input_signal[signal_lenght - 1];
+    uint32_t state = __atomic_load_n(&swap->swap_state, __ATOMIC_ACQUIRE);
+    if(state & IIR_SWAP_LOADED){
+        // Switch to the standby filter, unless IirSwapLoad() is replacing it
+        uint32_t next = (state & IIR_SWAP_ACTIVE) ^ IIR_SWAP_ACTIVE;
+        if(swap->fade_lenght > 0){
+            next |= IIR_SWAP_FADING;
+        }
+        if(__atomic_compare_exchange_n(&swap->swap_state, &state, next, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)){
+            IirSwapStart(swap, &swap->bank[state & IIR_SWAP_ACTIVE], &swap->bank[next & IIR_SWAP_ACTIVE]);
+            state = next;
+        }
+    }
+    iir_filter_t * active = &swap->bank[state & IIR_SWAP_ACTIVE];
+    int16_t i = 0;
+    if(state & IIR_SWAP_FADING){
+        iir_filter_t * previous = &swap->bank[(state & IIR_SWAP_ACTIVE) ^ IIR_SWAP_ACTIVE];
+        float step = 1.0f / (swap->fade_lenght + 1);
+        for(; (i < signal_lenght) && (swap->fade_pos < swap->fade_lenght); i++){
+            float x = input_signal[i];
+            float y_prev = IirStep(previous, x);
+            float y_next = IirStep(active, x);
+            swap->fade_pos++;
+            output_signal[i] = y_prev + (swap->fade_pos * step) * (y_next - y_prev);
+        }
+        if(swap->fade_pos == swap->fade_lenght){
+            // Previous filter released: IirSwapLoad() can use it
+            __atomic_store_n(&swap->swap_state, state & IIR_SWAP_ACTIVE, __ATOMIC_RELEASE);
+        }
+    }
+    if(i < signal_lenght){
+        IirFilter(active, &input_signal[i], &output_signal[i], signal_lenght - i);
     }
+    swap->last_sample = last_sample;
 }
 
 /*==================[end of file]============================================*/
\ No newline at end of file
@@ -0,0 +1,228 @@
+/**
+ * @file iir_fixed.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "iir_fixed.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+/*==================[macros and definitions]=================================*/
+#define TAG "IIR Fixed Module"
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+/**
+ * @brief Quantize the coefficients of a section with the most fractional bits such that
+ * the sum of their absolute values fits a coef_bits signed integer
+ *
+ * @param coeff_in      Float coefficients (b0, b1, b2, a1, a2)
+ * @param coeff_out     Quantized coefficients
+ * @param coef_bits     Bits of the coefficient type (16 or 32)
+ * @return int8_t       Fractional bits (-1: section can't be represented or is unstable)
+ */
+static int8_t IirQuantizeSection(const float * coeff_in, int64_t * coeff_out, uint8_t coef_bits);
+
+/**
+ * @brief Quantize all sections of a float filter
+ *
+ * @param filter        Pointer to float filter
+ * @param coeff_out     Quantized coefficients of each section
+ * @param frac_bits     Fractional bits of each section
+ * @param coef_bits     Bits of the coefficient type (16 or 32)
+ * @return true         All sections quantized
+ * @return false        A section can't be represented
+ */
+static bool IirQuantize(const iir_filter_t * filter, int64_t * coeff_out, uint8_t * frac_bits, uint8_t coef_bits);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static int8_t IirQuantizeSection(const float * coeff_in, int64_t * coeff_out, uint8_t coef_bits){
+    int64_t max_sum = ((int64_t)1 << (coef_bits - 1)) - 1;
+    for(int8_t f=coef_bits-1; f>=0; f--){
+        int64_t sum = 0;
+        for(uint8_t k=0; k<IIR_SOS_COEFF; k++){
+            coeff_out[k] = llround(ldexp(coeff_in[k], f));
+            sum += llabs(coeff_out[k]);
+        }
+        if(sum <= max_sum){
+            // Quantized poles must stay inside the unit circle: |a2| < 1, |a1| < 1 + a2
+            int64_t one = (int64_t)1 << f;
+            if((llabs(coeff_out[4]) >= one) || (llabs(coeff_out[3]) >= one + coeff_out[4])){
+                return -1;
+            }
+            return f;
+        }
+    }
+    return -1;
+}
+
+static bool IirQuantize(const iir_filter_t * filter, int64_t * coeff_out, uint8_t * frac_bits, uint8_t coef_bits){
+    if((filter->n_sos == 0) || (filter->n_sos > IIR_MAX_SOS)){
+        ESP_LOGE(TAG, "Invalid number of sections: %d", filter->n_sos);
+        return false;
+    }
+    for(uint8_t i=0; i<filter->n_sos; i++){
+        int8_t f = IirQuantizeSection(&filter->coeff[i * IIR_SOS_COEFF], &coeff_out[i * IIR_SOS_COEFF], coef_bits);
+        if(f < 0){
+            ESP_LOGE(TAG, "Section %d can't be quantized to %d bits", i, coef_bits);
+            return false;
+        }
+        frac_bits[i] = f;
+    }
+    return true;
+}
+
+/**
+ * @brief One sample through one Q15 section (direct form I)
+ */
+static inline __attribute__((always_inline)) int16_t IirQ15Section(const int16_t * c, uint8_t f, int16_t * s, int32_t * e, iir_shaping_t shaping, int16_t x){
+    // Sum of |c| < 2^15: no overflow
+    int32_t acc = c[0] * x + c[1] * s[0] + c[2] * s[1] - c[3] * s[2] - c[4] * s[3];
+    if(shaping == IIR_ROUND){
+        acc += (1 << f) >> 1;
+    }
+    else if(shaping == IIR_SHAPING_1){
+        acc += e[0];
+    }
+    else{
+        acc += 2 * e[0] - e[1];
+    }
+    int32_t y = acc >> f;
+    int32_t err = acc - y * (1 << f);
+    if(y > INT16_MAX){
+        y = INT16_MAX;
+        err = 0;
+    }
+    else if(y < INT16_MIN){
+        y = INT16_MIN;
+        err = 0;
+    }
+    e[1] = e[0];
+    e[0] = err;
+    s[1] = s[0];
+    s[0] = x;
+    s[3] = s[2];
+    s[2] = y;
+    return y;
+}
+
+static inline __attribute__((always_inline)) int16_t IirQ15Sample(iir_q15_t * q15, int16_t x){
+    for(uint8_t i=0; i<q15->n_sos; i++){
+        x = IirQ15Section(&q15->coeff[i * IIR_SOS_COEFF], q15->frac_bits[i], &q15->state[i * IIR_DF1_STATE], &q15->error[i * 2], q15->shaping, x);
+    }
+    return x;
+}
+
+/**
+ * @brief One sample through one Q31 section (direct form I)
+ */
+static inline __attribute__((always_inline)) int32_t IirQ31Section(const int32_t * c, uint8_t f, int32_t * s, int64_t * e, iir_shaping_t shaping, int32_t x){
+    // Sum of |c| < 2^31: no overflow
+    int64_t acc = (int64_t)c[0] * x + (int64_t)c[1] * s[0] + (int64_t)c[2] * s[1] - (int64_t)c[3] * s[2] - (int64_t)c[4] * s[3];
+    if(shaping == IIR_ROUND){
+        acc += ((int64_t)1 << f) >> 1;
+    }
+    else if(shaping == IIR_SHAPING_1){
+        acc += e[0];
+    }
+    else{
+        acc += 2 * e[0] - e[1];
+    }
+    int64_t y = acc >> f;
+    int64_t err = acc - y * ((int64_t)1 << f);
+    if(y > INT32_MAX){
+        y = INT32_MAX;
+        err = 0;
+    }
+    else if(y < INT32_MIN){
+        y = INT32_MIN;
+        err = 0;
+    }
+    e[1] = e[0];
+    e[0] = err;
+    s[1] = s[0];
+    s[0] = x;
+    s[3] = s[2];
+    s[2] = y;
+    return y;
+}
+
+static inline __attribute__((always_inline)) int32_t IirQ31Sample(iir_q31_t * q31, int32_t x){
+    for(uint8_t i=0; i<q31->n_sos; i++){
+        x = IirQ31Section(&q31->coeff[i * IIR_SOS_COEFF], q31->frac_bits[i], &q31->state[i * IIR_DF1_STATE], &q31->error[i * 2], q31->shaping, x);
+    }
+    return x;
+}
+
+/*==================[external functions definition]==========================*/
+bool IirQ15Init(iir_q15_t * q15, const iir_filter_t * filter, iir_shaping_t shaping){
+    int64_t coeff[IIR_MAX_SOS * IIR_SOS_COEFF];
+    memset(q15, 0, sizeof(iir_q15_t));
+    if(!IirQuantize(filter, coeff, q15->frac_bits, 16)){
+        return false;
+    }
+    for(uint8_t k=0; k<filter->n_sos * IIR_SOS_COEFF; k++){
+        q15->coeff[k] = coeff[k];
+    }
+    q15->n_sos = filter->n_sos;
+    q15->shaping = shaping;
+    return true;
+}
+
+void IirQ15Filter(iir_q15_t * q15, const int16_t * input_signal, int16_t * output_signal, int16_t signal_lenght){
+    for(int16_t i=0; i<signal_lenght; i++){
+        output_signal[i] = IirQ15Sample(q15, input_signal[i]);
+    }
+}
+
+int16_t IRAM_ATTR IirQ15Step(iir_q15_t * q15, int16_t sample){
+    return IirQ15Sample(q15, sample);
+}
+
+void IirQ15Reset(iir_q15_t * q15){
+    memset(q15->state, 0, sizeof(q15->state));
+    memset(q15->error, 0, sizeof(q15->error));
+}
+
+bool IirQ31Init(iir_q31_t * q31, const iir_filter_t * filter, iir_shaping_t shaping){
+    int64_t coeff[IIR_MAX_SOS * IIR_SOS_COEFF];
+    memset(q31, 0, sizeof(iir_q31_t));
+    if(!IirQuantize(filter, coeff, q31->frac_bits, 32)){
+        return false;
+    }
+    for(uint8_t k=0; k<filter->n_sos * IIR_SOS_COEFF; k++){
+        q31->coeff[k] = coeff[k];
+    }
+    q31->n_sos = filter->n_sos;
+    q31->shaping = shaping;
+    return true;
+}
+
+void IirQ31Filter(iir_q31_t * q31, const int32_t * input_signal, int32_t * output_signal, int16_t signal_lenght){
+    for(int16_t i=0; i<signal_lenght; i++){
+        output_signal[i] = IirQ31Sample(q31, input_signal[i]);
+    }
+}
+
+int32_t IRAM_ATTR IirQ31Step(iir_q31_t * q31, int32_t sample){
+    return IirQ31Sample(q31, sample);
+}
+
+void IirQ31Reset(iir_q31_t * q31){
+    memset(q31->state, 0, sizeof(q31->state));
+    memset(q31->error, 0, sizeof(q31->error));
+}
+
+/*==================[end of file]============================================*/
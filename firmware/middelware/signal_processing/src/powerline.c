@@ -0,0 +1,264 @@
+/**
+ * @file powerline.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "powerline.h"
+#include "esp_log.h"
+/*==================[macros and definitions]=================================*/
+#define TAG "Powerline Module"
+#define POWERLINE_SINE_BITS     9       /*!< log2 of sine table size */
+#define POWERLINE_SINE_SIZE     (1 << POWERLINE_SINE_BITS)
+#define POWERLINE_WEIGHT_FRAC   14      /*!< Fractional bits of Q15 weights */
+#define POWERLINE_TRACK_GAIN    0.5f    /*!< Fraction of the measured frequency error corrected per update */
+#define POWERLINE_RAD_TO_PHASE  683565276LL /*!< 2^32 / (2 * pi) */
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+/**
+ * @brief Check a configuration and compute the LMS step size
+ *
+ * @param config        Pointer to configuration
+ * @param mu            LMS step size
+ * @return true         Valid configuration
+ * @return false        Invalid configuration
+ */
+static bool PowerlineCheckConfig(powerline_config_t * config, float * mu);
+
+/**
+ * @brief Interpolated Q15 sine
+ *
+ * @param phase         Phase (2^32 = 2*pi)
+ * @return int32_t      sin(phase) * 2^15
+ */
+static inline int32_t PowerlineSine(uint32_t phase);
+/*==================[internal data definition]===============================*/
+static int16_t sine_table[POWERLINE_SINE_SIZE + 1];    /*!< One period of sine (Q15), first sample repeated */
+static bool sine_table_ready = false;
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static bool PowerlineCheckConfig(powerline_config_t * config, float * mu){
+    if((config->harmonics == 0) || (config->harmonics > POWERLINE_MAX_HARMONICS)){
+        ESP_LOGE(TAG, "Invalid number of harmonics: %d", config->harmonics);
+        return false;
+    }
+    if((config->line_freq <= 0) || (config->max_deviation < 0) || (config->max_deviation >= config->line_freq) ||
+        (config->harmonics * (config->line_freq + config->max_deviation) >= config->sample_freq / 2)){
+        ESP_LOGE(TAG, "Invalid line frequency: %.2f +- %.2f Hz (%d harmonics)", config->line_freq, config->max_deviation, config->harmonics);
+        return false;
+    }
+    // Two weights LMS with unit amplitude references: notch of bandwidth mu * fs / (2 * pi)
+    *mu = 2 * M_PI * config->bandwidth / config->sample_freq;
+    // Sum of reference powers is harmonics: stable (and notches don't overlap) for mu * harmonics << 2
+    if((config->bandwidth <= 0) || (*mu * config->harmonics >= 1)){
+        ESP_LOGE(TAG, "Invalid bandwidth: %.2f Hz", config->bandwidth);
+        return false;
+    }
+    return true;
+}
+
+static inline int32_t PowerlineSine(uint32_t phase){
+    uint32_t idx = phase >> (32 - POWERLINE_SINE_BITS);
+    int32_t frac = (phase >> (17 - POWERLINE_SINE_BITS)) & 0x7FFF;
+    int32_t s0 = sine_table[idx];
+    return s0 + (((sine_table[idx + 1] - s0) * frac) >> 15);
+}
+
+/*==================[external functions definition]==========================*/
+bool PowerlineInit(powerline_t * pl, powerline_config_t * config){
+    float mu;
+    memset(pl, 0, sizeof(powerline_t));
+    if(!PowerlineCheckConfig(config, &mu)){
+        return false;
+    }
+    pl->harmonics = config->harmonics;
+    pl->mu = mu;
+    pl->sample_freq = config->sample_freq;
+    pl->omega = 2 * M_PI * config->line_freq / config->sample_freq;
+    pl->omega_min = 2 * M_PI * (config->line_freq - config->max_deviation) / config->sample_freq;
+    pl->omega_max = 2 * M_PI * (config->line_freq + config->max_deviation) / config->sample_freq;
+    pl->osc_step[0] = cosf(pl->omega);
+    pl->osc_step[1] = sinf(pl->omega);
+    pl->osc[0] = 1;
+    return true;
+}
+
+void PowerlineFilter(powerline_t * pl, const float * input_signal, float * output_signal, int16_t signal_lenght){
+    float ref[2 * POWERLINE_MAX_HARMONICS];
+    uint8_t n_ref = 2 * pl->harmonics;
+    float osc_re = pl->osc[0], osc_im = pl->osc[1];
+    for(int16_t i=0; i<signal_lenght; i++){
+        // References: cos(k * theta), sin(k * theta) from powers of the oscillator
+        float c = osc_re, s = osc_im;
+        float y = 0;
+        for(uint8_t k=0; k<n_ref; k+=2){
+            ref[k] = c;
+            ref[k + 1] = s;
+            y += pl->weight[k] * c + pl->weight[k + 1] * s;
+            float c_next = c * osc_re - s * osc_im;
+            s = c * osc_im + s * osc_re;
+            c = c_next;
+        }
+        float e = input_signal[i] - y;
+        float mu_e = pl->mu * e;
+        for(uint8_t k=0; k<n_ref; k++){
+            pl->weight[k] += mu_e * ref[k];
+        }
+        output_signal[i] = e;
+        float re = osc_re * pl->osc_step[0] - osc_im * pl->osc_step[1];
+        osc_im = osc_re * pl->osc_step[1] + osc_im * pl->osc_step[0];
+        osc_re = re;
+        if(++pl->count == POWERLINE_TRACK_PERIOD){
+            pl->count = 0;
+            // Keep the oscillator on the unit circle
+            float g = 1.5f - 0.5f * (osc_re * osc_re + osc_im * osc_im);
+            osc_re *= g;
+            osc_im *= g;
+            if(pl->omega_max > pl->omega_min){
+                // Fundamental's phasor W = wc - j*ws rotates at the frequency error: arg(W * conj(W_prev))
+                float wc = pl->weight[0], ws = pl->weight[1];
+                float rot_re = wc * pl->weight_prev[0] + ws * pl->weight_prev[1];
+                float rot_im = wc * pl->weight_prev[1] - ws * pl->weight_prev[0];
+                if(rot_re > 0){
+                    pl->omega += POWERLINE_TRACK_GAIN * atan2f(rot_im, rot_re) / POWERLINE_TRACK_PERIOD;
+                    if(pl->omega > pl->omega_max){
+                        pl->omega = pl->omega_max;
+                    }
+                    else if(pl->omega < pl->omega_min){
+                        pl->omega = pl->omega_min;
+                    }
+                    pl->osc_step[0] = cosf(pl->omega);
+                    pl->osc_step[1] = sinf(pl->omega);
+                }
+                pl->weight_prev[0] = wc;
+                pl->weight_prev[1] = ws;
+            }
+        }
+    }
+    pl->osc[0] = osc_re;
+    pl->osc[1] = osc_im;
+}
+
+float PowerlineFrequency(powerline_t * pl){
+    return pl->omega * pl->sample_freq / (2 * M_PI);
+}
+
+void PowerlineReset(powerline_t * pl){
+    memset(pl->weight, 0, sizeof(pl->weight));
+    memset(pl->weight_prev, 0, sizeof(pl->weight_prev));
+    pl->osc[0] = 1;
+    pl->osc[1] = 0;
+    pl->count = 0;
+}
+
+bool PowerlineQ15Init(powerline_q15_t * pl, powerline_config_t * config){
+    float mu;
+    memset(pl, 0, sizeof(powerline_q15_t));
+    if(!PowerlineCheckConfig(config, &mu)){
+        return false;
+    }
+    if(!sine_table_ready){
+        for(uint16_t i=0; i<POWERLINE_SINE_SIZE; i++){
+            sine_table[i] = lroundf(32767 * sinf(2 * M_PI * i / POWERLINE_SINE_SIZE));
+        }
+        sine_table[POWERLINE_SINE_SIZE] = sine_table[0];
+        sine_table_ready = true;
+    }
+    pl->harmonics = config->harmonics;
+    pl->mu = lroundf(mu * (1 << 15));
+    if(pl->mu == 0){
+        pl->mu = 1;
+    }
+    pl->sample_freq = config->sample_freq;
+    pl->phase_step = llround(ldexp(config->line_freq / config->sample_freq, 32));
+    pl->phase_step_min = llround(ldexp((config->line_freq - config->max_deviation) / config->sample_freq, 32));
+    pl->phase_step_max = llround(ldexp((config->line_freq + config->max_deviation) / config->sample_freq, 32));
+    return true;
+}
+
+void PowerlineQ15Filter(powerline_q15_t * pl, const int16_t * input_signal, int16_t * output_signal, int16_t signal_lenght){
+    int32_t ref[2 * POWERLINE_MAX_HARMONICS];
+    uint8_t n_ref = 2 * pl->harmonics;
+    for(int16_t i=0; i<signal_lenght; i++){
+        uint32_t phase = 0;
+        int64_t acc = 0;
+        for(uint8_t k=0; k<n_ref; k+=2){
+            phase += pl->phase;
+            ref[k] = PowerlineSine(phase + (1UL << 30));
+            ref[k + 1] = PowerlineSine(phase);
+            acc += (int64_t)pl->weight[k] * ref[k] + (int64_t)pl->weight[k + 1] * ref[k + 1];
+        }
+        int32_t y = (acc + (1LL << (POWERLINE_WEIGHT_FRAC + 14))) >> (POWERLINE_WEIGHT_FRAC + 15);
+        int32_t e = input_signal[i] - y;
+        if(e > INT16_MAX){
+            e = INT16_MAX;
+        }
+        else if(e < INT16_MIN){
+            e = INT16_MIN;
+        }
+        // mu * e (Q15) * ref (Q15) to weight scale (2^14): >> 16
+        int32_t mu_e = pl->mu * e;
+        for(uint8_t k=0; k<n_ref; k++){
+            pl->weight[k] += ((int64_t)mu_e * ref[k] + (1 << 15)) >> (30 - POWERLINE_WEIGHT_FRAC);
+        }
+        output_signal[i] = e;
+        pl->phase += pl->phase_step;
+        if(++pl->count == POWERLINE_TRACK_PERIOD){
+            pl->count = 0;
+            if(pl->phase_step_max > pl->phase_step_min){
+                int32_t wc = pl->weight[0], ws = pl->weight[1];
+                int32_t pc = pl->weight_prev[0], ps = pl->weight_prev[1];
+                // Scale down to 15 bits so that the products fit int32_t
+                int32_t max = abs(wc) | abs(ws) | abs(pc) | abs(ps);
+                uint8_t shift = 0;
+                while((max >> shift) >= (1 << 15)){
+                    shift++;
+                }
+                wc >>= shift;
+                ws >>= shift;
+                pc >>= shift;
+                ps >>= shift;
+                int32_t rot_re = wc * pc + ws * ps;
+                int32_t rot_im = wc * ps - ws * pc;
+                if(rot_re > 0){
+                    // Small angle: arg ~= rot_im / rot_re (|arg| < 0.2 rad for 0.5 Hz at 500 Hz)
+                    int64_t delta = ((int64_t)rot_im * (POWERLINE_RAD_TO_PHASE / (2 * POWERLINE_TRACK_PERIOD))) / rot_re;
+                    int64_t step = (int64_t)pl->phase_step + delta;
+                    if(step > pl->phase_step_max){
+                        step = pl->phase_step_max;
+                    }
+                    else if(step < pl->phase_step_min){
+                        step = pl->phase_step_min;
+                    }
+                    pl->phase_step = step;
+                }
+                pl->weight_prev[0] = pl->weight[0];
+                pl->weight_prev[1] = pl->weight[1];
+            }
+        }
+    }
+}
+
+float PowerlineQ15Frequency(powerline_q15_t * pl){
+    return ldexpf(pl->phase_step, -32) * pl->sample_freq;
+}
+
+void PowerlineQ15Reset(powerline_q15_t * pl){
+    memset(pl->weight, 0, sizeof(pl->weight));
+    memset(pl->weight_prev, 0, sizeof(pl->weight_prev));
+    pl->phase = 0;
+    pl->count = 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,167 @@
+/**
+ * @file resample.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "resample.h"
+#include "esp_dsp.h"
+#include "esp_log.h"
+/*==================[macros and definitions]=================================*/
+#define TAG "Resample Module"
+#define RESAMPLE_TAPS_PER_FACTOR    24      /*!< Default filter taps per unit of max(interp, decim) */
+#define RESAMPLE_HALF_TRANSITION    2.75f   /*!< Half transition band of Blackman window (times 1 / taps) */
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+/**
+ * @brief Greatest common divisor
+ */
+static uint16_t ResampleGcd(uint16_t a, uint16_t b);
+
+/**
+ * @brief Design a Blackman windowed sinc low pass filter with unity DC gain
+ *
+ * @param coeffs    Array to store coefficients
+ * @param lenght    Number of taps
+ * @param cutoff    Cutoff frequency normalized to sample frequency (0 to 0.5)
+ */
+static void ResampleLowPass(float * coeffs, uint16_t lenght, float cutoff);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static uint16_t ResampleGcd(uint16_t a, uint16_t b){
+    while(b != 0){
+        uint16_t r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+static void ResampleLowPass(float * coeffs, uint16_t lenght, float cutoff){
+    float sum = 0;
+    float center = (lenght - 1) / 2.0f;
+    dsps_wind_blackman_f32(coeffs, lenght);
+    for(uint16_t i=0; i<lenght; i++){
+        float x = 2 * cutoff * (i - center);
+        if(x != 0){
+            coeffs[i] *= sinf(M_PI * x) / (M_PI * x);
+        }
+        sum += coeffs[i];
+    }
+    for(uint16_t i=0; i<lenght; i++){
+        coeffs[i] /= sum;
+    }
+}
+
+/*==================[external functions definition]==========================*/
+bool ResampleInit(resample_t * resample, resample_config_t * config){
+    memset(resample, 0, sizeof(resample_t));
+    if((config->interp == 0) || (config->decim == 0)){
+        ESP_LOGE(TAG, "Invalid factors: %d / %d", config->interp, config->decim);
+        return false;
+    }
+    uint16_t gcd = ResampleGcd(config->interp, config->decim);
+    uint16_t l = config->interp / gcd;
+    uint16_t m = config->decim / gcd;
+    if((l > RESAMPLE_MAX_FACTOR) || (m > RESAMPLE_MAX_FACTOR)){
+        ESP_LOGE(TAG, "Invalid factors: %d / %d", l, m);
+        return false;
+    }
+    uint16_t factor = (l > m) ? l : m;
+    uint32_t lenght = config->fir_lenght;
+    if(lenght == 0){
+        lenght = RESAMPLE_TAPS_PER_FACTOR * factor;
+    }
+    // Whole number of taps per phase
+    uint16_t taps = (lenght + l - 1) / l;
+    if(taps < 2){
+        ESP_LOGE(TAG, "Invalid filter lenght: %d", (int)lenght);
+        return false;
+    }
+    resample->interp = l;
+    resample->decim = m;
+    resample->taps = taps;
+    resample->bank = malloc((uint32_t)l * taps * sizeof(float));
+    resample->delay = malloc(2 * taps * sizeof(float));
+    float * coeffs = malloc(lenght * sizeof(float));
+    if((resample->bank == NULL) || (resample->delay == NULL) || (coeffs == NULL)){
+        ESP_LOGE(TAG, "Not enough memory for resampler");
+        free(coeffs);
+        ResampleDeinit(resample);
+        return false;
+    }
+    // Stop band from the lower Nyquist frequency (normalized to fs_in * interp)
+    float cutoff = (0.5f - RESAMPLE_HALF_TRANSITION * factor / lenght) / factor;
+    if(cutoff < 0.25f / factor){
+        cutoff = 0.25f / factor;
+    }
+    ResampleLowPass(coeffs, lenght, cutoff);
+    // Phase p: taps p, p + l, p + 2l... time reversed, with gain l (interpolation zeros)
+    for(uint16_t p=0; p<l; p++){
+        float * phase = &resample->bank[p * taps];
+        for(uint16_t k=0; k<taps; k++){
+            uint32_t n = (uint32_t)k * l + p;
+            phase[taps - 1 - k] = (n < lenght) ? l * coeffs[n] : 0;
+        }
+    }
+    free(coeffs);
+    ResampleReset(resample);
+    return true;
+}
+
+void ResampleDeinit(resample_t * resample){
+    free(resample->bank);
+    free(resample->delay);
+    memset(resample, 0, sizeof(resample_t));
+}
+
+uint16_t ResampleOutputLenght(resample_t * resample, uint16_t input_lenght){
+    return ((uint32_t)input_lenght * resample->interp + resample->decim - 1) / resample->decim;
+}
+
+uint16_t ResampleProcess(resample_t * resample, const float * input_signal, uint16_t input_lenght, float * output_signal){
+    uint16_t l = resample->interp;
+    uint16_t m = resample->decim;
+    uint16_t taps = resample->taps;
+    uint16_t phase = resample->phase;
+    uint16_t pos = resample->pos;
+    float * delay = resample->delay;
+    uint16_t n = 0;
+    for(uint16_t i=0; i<input_lenght; i++){
+        // Each sample is stored twice, so the last taps samples are always contiguous
+        delay[pos] = input_signal[i];
+        delay[pos + taps] = input_signal[i];
+        if(++pos == taps){
+            pos = 0;
+        }
+        while(phase < l){
+            dsps_dotprod_f32(&delay[pos], &resample->bank[phase * taps], &output_signal[n++], taps);
+            phase += m;
+        }
+        phase -= l;
+    }
+    resample->phase = phase;
+    resample->pos = pos;
+    return n;
+}
+
+void ResampleReset(resample_t * resample){
+    memset(resample->delay, 0, 2 * resample->taps * sizeof(float));
+    resample->phase = 0;
+    resample->pos = 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,121 @@
+/**
+ * @file sliding_dft.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "sliding_dft.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+/*==================[macros and definitions]=================================*/
+#define TAG "Sliding DFT Module"
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+bool SlidingDFTInit(sliding_dft_t * sdft, sliding_dft_config_t * config){
+    memset(sdft, 0, sizeof(sliding_dft_t));
+    if((config->window_lenght == 0) || (config->n_bins == 0) ||
+       (config->damping <= 0) || (config->damping > 1)){
+        ESP_LOGE(TAG, "Invalid configuration");
+        return false;
+    }
+    for(uint16_t i=0; i<config->n_bins; i++){
+        if(config->bins[i] >= config->window_lenght / 2){
+            ESP_LOGE(TAG, "Invalid bin: %d", config->bins[i]);
+            return false;
+        }
+    }
+    sdft->window_lenght = config->window_lenght;
+    sdft->n_bins = config->n_bins;
+    sdft->damping_n = powf(config->damping, config->window_lenght);
+    sdft->delay = calloc(config->window_lenght, sizeof(float));
+    sdft->bins = malloc(config->n_bins * sizeof(uint16_t));
+    sdft->coeff = malloc(2 * config->n_bins * sizeof(float));
+    sdft->state = calloc(2 * config->n_bins, sizeof(float));
+    if((sdft->delay == NULL) || (sdft->bins == NULL) || (sdft->coeff == NULL) || (sdft->state == NULL)){
+        ESP_LOGE(TAG, "Not enough memory for sliding DFT");
+        SlidingDFTDeinit(sdft);
+        return false;
+    }
+    memcpy(sdft->bins, config->bins, config->n_bins * sizeof(uint16_t));
+    for(uint16_t i=0; i<config->n_bins; i++){
+        float angle = 2 * M_PI * config->bins[i] / (float)config->window_lenght;
+        sdft->coeff[2 * i + 0] = config->damping * cosf(angle);
+        sdft->coeff[2 * i + 1] = config->damping * sinf(angle);
+    }
+    return true;
+}
+
+void SlidingDFTDeinit(sliding_dft_t * sdft){
+    free(sdft->delay);
+    free(sdft->bins);
+    free(sdft->coeff);
+    free(sdft->state);
+    memset(sdft, 0, sizeof(sliding_dft_t));
+}
+
+void IRAM_ATTR SlidingDFTUpdate(sliding_dft_t * sdft, float sample){
+    // X_k(n) = r * exp(j*2*pi*k/N) * (X_k(n-1) + x(n) - r^N * x(n-N))
+    float delta = sample - sdft->damping_n * sdft->delay[sdft->index];
+    sdft->delay[sdft->index] = sample;
+    sdft->index++;
+    if(sdft->index == sdft->window_lenght){
+        sdft->index = 0;
+    }
+    float * coeff = sdft->coeff;
+    float * state = sdft->state;
+    for(uint16_t i=0; i<sdft->n_bins; i++){
+        float re = state[0] + delta;
+        float im = state[1];
+        state[0] = re * coeff[0] - im * coeff[1];
+        state[1] = re * coeff[1] + im * coeff[0];
+        state += 2;
+        coeff += 2;
+    }
+}
+
+void SlidingDFTMagnitude(sliding_dft_t * sdft, float * magnitude){
+    SlidingDFTPower(sdft, magnitude);
+    for(uint16_t i=0; i<sdft->n_bins; i++){
+        magnitude[i] = sqrtf(magnitude[i]);
+    }
+}
+
+void SlidingDFTPower(sliding_dft_t * sdft, float * power){
+    float scale = 4.0f / sdft->window_lenght;
+    scale = scale * scale;
+    for(uint16_t i=0; i<sdft->n_bins; i++){
+        float re = sdft->state[2 * i + 0];
+        float im = sdft->state[2 * i + 1];
+        power[i] = (re * re + im * im) * scale;
+        if(sdft->bins[i] == 0){
+            // DC is not split between positive and negative frequencies
+            power[i] = power[i] / 16;
+        }
+    }
+}
+
+void SlidingDFTReset(sliding_dft_t * sdft){
+    sdft->index = 0;
+    memset(sdft->delay, 0, sdft->window_lenght * sizeof(float));
+    memset(sdft->state, 0, 2 * sdft->n_bins * sizeof(float));
+}
+
+/*==================[end of file]============================================*/
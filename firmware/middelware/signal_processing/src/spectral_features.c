@@ -0,0 +1,277 @@
+/**
+ * @file spectral_features.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "spectral_features.h"
+#include "esp_log.h"
+/*==================[macros and definitions]=================================*/
+#define TAG "Spectral Features Module"
+#define LOG2_FRAC_BITS  16          /*!< Fractional bits of integer log2 */
+#define LOG2_CORR_Q16   22713       /*!< 0.3466 in Q16, parabolic correction of log2(1+x) ~ x */
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+/**
+ * @brief Convert a frequency to the nearest bin inside [0, n_bins - 1]
+ *
+ * @param freq      Frequency (Hz)
+ * @param freq_step Frequency resolution (Hz)
+ * @param n_bins    Number of bins
+ * @param round_up  true: first bin >= freq, false: last bin <= freq
+ * @return int32_t  Bin index (-1 if freq is lower than bin 0, n_bins if higher than last bin)
+ */
+static int32_t SpectralBin(float freq, float freq_step, uint16_t n_bins, bool round_up);
+
+/**
+ * @brief Integer base 2 logarithm (max error ~0.005)
+ *
+ * @param x         Value (> 0)
+ * @return uint32_t log2(x) in Q16
+ */
+static uint32_t SpectralLog2(uint32_t x);
+
+/**
+ * @brief Calculate the features derived from the accumulated sums
+ *
+ * @param ctx       Pointer to spectral features context
+ * @param features  Pointer to store features
+ * @param m0        Sum of values
+ * @param m1        Sum of bin * value
+ * @param m2        Sum of bin^2 * value
+ * @param m3        Sum of bin^3 * value
+ * @param median    Median bin
+ * @param peak      Bin of maximum value
+ */
+static void SpectralMoments(spectral_ctx_t * ctx, spectral_features_t * features, float m0, float m1, float m2, float m3, uint16_t median, uint16_t peak);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static int32_t SpectralBin(float freq, float freq_step, uint16_t n_bins, bool round_up){
+    float bin = freq / freq_step;
+    int32_t index = round_up ? (int32_t)ceilf(bin) : (int32_t)floorf(bin);
+    if(index < -1){
+        index = -1;
+    }
+    if(index > n_bins){
+        index = n_bins;
+    }
+    return index;
+}
+
+static uint32_t SpectralLog2(uint32_t x){
+    uint32_t msb = 31 - __builtin_clz(x);
+    /* Mantissa in [1, 2) as Q16 fraction */
+    uint32_t frac = (msb >= LOG2_FRAC_BITS) ? (x >> (msb - LOG2_FRAC_BITS)) : (x << (LOG2_FRAC_BITS - msb));
+    frac &= (1 << LOG2_FRAC_BITS) - 1;
+    /* log2(1 + f) ~ f + 0.3466 * f * (1 - f) */
+    uint32_t corr = (frac * ((1 << LOG2_FRAC_BITS) - frac)) >> LOG2_FRAC_BITS;
+    corr = (corr * LOG2_CORR_Q16) >> LOG2_FRAC_BITS;
+    return (msb << LOG2_FRAC_BITS) + frac + corr;
+}
+
+static void SpectralMoments(spectral_ctx_t * ctx, spectral_features_t * features, float m0, float m1, float m2, float m3, uint16_t median, uint16_t peak){
+    float mean = m1 / m0;
+    float var = m2 / m0 - mean * mean;
+    features->mean_freq = mean * ctx->freq_step;
+    features->median_freq = median * ctx->freq_step;
+    features->peak_freq = peak * ctx->freq_step;
+    if(var > 0){
+        features->spread = sqrtf(var) * ctx->freq_step;
+        features->skewness = (m3 / m0 - 3.0f * mean * var - mean * mean * mean) / (var * sqrtf(var));
+    }
+}
+
+/*==================[external functions definition]==========================*/
+bool SpectralFeaturesInit(spectral_ctx_t * ctx, spectral_config_t * config){
+    memset(ctx, 0, sizeof(spectral_ctx_t));
+    uint16_t n_bins = config->signal_lenght / 2;
+    if((n_bins == 0) || (config->sample_freq <= 0)){
+        ESP_LOGE(TAG, "Invalid signal lenght: %d", config->signal_lenght);
+        return false;
+    }
+    if((config->n_bands > SPECTRAL_MAX_BANDS) || ((config->n_bands > 0) && (config->bands == NULL))){
+        ESP_LOGE(TAG, "Invalid number of bands: %d", config->n_bands);
+        return false;
+    }
+    ctx->freq_step = config->sample_freq / config->signal_lenght;
+    ctx->format = config->format;
+    ctx->entropy = config->entropy;
+    int32_t bin_min = SpectralBin(config->f_min, ctx->freq_step, n_bins, true);
+    int32_t bin_max = (config->f_max > 0) ? SpectralBin(config->f_max, ctx->freq_step, n_bins, false) : (n_bins - 1);
+    if(bin_min < 0){
+        bin_min = 0;
+    }
+    if(bin_max > (n_bins - 1)){
+        bin_max = n_bins - 1;
+    }
+    if(bin_min > bin_max){
+        ESP_LOGE(TAG, "Invalid frequency range: %.2f - %.2f Hz", config->f_min, config->f_max);
+        return false;
+    }
+    ctx->bin_min = bin_min;
+    ctx->bin_max = bin_max;
+    /* Bands are clipped to the analyzed range, an empty band has band_low > band_high */
+    ctx->n_bands = config->n_bands;
+    for(uint8_t i=0; i<config->n_bands; i++){
+        int32_t low = SpectralBin(config->bands[i].f_low, ctx->freq_step, n_bins, true);
+        int32_t high = SpectralBin(config->bands[i].f_high, ctx->freq_step, n_bins, false);
+        if(low < bin_min){
+            low = bin_min;
+        }
+        if(high > bin_max){
+            high = bin_max;
+        }
+        if(low > high){
+            low = bin_max + 1;
+            high = bin_max;
+        }
+        ctx->band_low[i] = low;
+        ctx->band_high[i] = high;
+    }
+    uint16_t n = bin_max - bin_min + 1;
+    if(ctx->format == SPECTRAL_FLOAT){
+        ctx->cumulative = malloc(n * sizeof(float));
+    }
+    else{
+        ctx->cumulative_int = malloc(n * sizeof(uint32_t));
+    }
+    if((ctx->cumulative == NULL) && (ctx->cumulative_int == NULL)){
+        ESP_LOGE(TAG, "Not enough memory for spectral features");
+        SpectralFeaturesDeinit(ctx);
+        return false;
+    }
+    return true;
+}
+
+void SpectralFeaturesDeinit(spectral_ctx_t * ctx){
+    free(ctx->cumulative);
+    free(ctx->cumulative_int);
+    memset(ctx, 0, sizeof(spectral_ctx_t));
+}
+
+void SpectralFeaturesCalc(spectral_ctx_t * ctx, const float * spectrum, spectral_features_t * features){
+    float * cumulative = ctx->cumulative;
+    float m0 = 0, m1 = 0, m2 = 0, m3 = 0, plogp = 0;
+    float peak_value = spectrum[ctx->bin_min];
+    uint16_t peak = ctx->bin_min;
+    memset(features, 0, sizeof(spectral_features_t));
+    /* Single pass: moments, peak, entropy and cumulative sum */
+    for(uint16_t i=ctx->bin_min; i<=ctx->bin_max; i++){
+        float value = spectrum[i];
+        float k = i;
+        float kv = k * value;
+        float k2v = k * kv;
+        m0 += value;
+        m1 += kv;
+        m2 += k2v;
+        m3 += k * k2v;
+        if(value > peak_value){
+            peak_value = value;
+            peak = i;
+        }
+        if(ctx->entropy && (value > 0)){
+            plogp += value * log2f(value);
+        }
+        *cumulative++ = m0;
+    }
+    features->total = m0;
+    features->peak_value = peak_value;
+    if(m0 <= 0){
+        return;
+    }
+    /* Median: first bin whose cumulative sum reaches half of total */
+    float half = m0 / 2.0f;
+    uint16_t low = 0, high = ctx->bin_max - ctx->bin_min;
+    while(low < high){
+        uint16_t mid = (low + high) / 2;
+        if(ctx->cumulative[mid] >= half){
+            high = mid;
+        }
+        else{
+            low = mid + 1;
+        }
+    }
+    SpectralMoments(ctx, features, m0, m1, m2, m3, ctx->bin_min + low, peak);
+    if(ctx->entropy){
+        features->entropy = log2f(m0) - plogp / m0;
+    }
+    for(uint8_t b=0; b<ctx->n_bands; b++){
+        if(ctx->band_low[b] <= ctx->band_high[b]){
+            features->band[b] = ctx->cumulative[ctx->band_high[b] - ctx->bin_min];
+            if(ctx->band_low[b] > ctx->bin_min){
+                features->band[b] -= ctx->cumulative[ctx->band_low[b] - ctx->bin_min - 1];
+            }
+        }
+    }
+}
+
+void SpectralFeaturesCalcQ15(spectral_ctx_t * ctx, const uint16_t * spectrum, int8_t exponent, spectral_features_t * features){
+    uint32_t * cumulative = ctx->cumulative_int;
+    uint32_t m0 = 0;
+    uint64_t m1 = 0, m2 = 0, m3 = 0, plogp = 0;
+    uint16_t peak_value = spectrum[ctx->bin_min];
+    uint16_t peak = ctx->bin_min;
+    memset(features, 0, sizeof(spectral_features_t));
+    /* Single pass: moments, peak, entropy and cumulative sum (integer operations only) */
+    for(uint16_t i=ctx->bin_min; i<=ctx->bin_max; i++){
+        uint32_t value = spectrum[i];
+        uint64_t kv = (uint64_t)i * value;
+        uint64_t k2v = i * kv;
+        m0 += value;
+        m1 += kv;
+        m2 += k2v;
+        m3 += i * k2v;
+        if(value > peak_value){
+            peak_value = value;
+            peak = i;
+        }
+        if(ctx->entropy && (value > 0)){
+            plogp += (uint64_t)value * SpectralLog2(value);
+        }
+        *cumulative++ = m0;
+    }
+    features->total = ldexpf((float)m0, exponent);
+    features->peak_value = ldexpf((float)peak_value, exponent);
+    if(m0 == 0){
+        return;
+    }
+    /* Median: first bin whose cumulative sum reaches half of total */
+    uint16_t low = 0, high = ctx->bin_max - ctx->bin_min;
+    while(low < high){
+        uint16_t mid = (low + high) / 2;
+        if((2 * ctx->cumulative_int[mid]) >= m0){
+            high = mid;
+        }
+        else{
+            low = mid + 1;
+        }
+    }
+    SpectralMoments(ctx, features, (float)m0, (float)m1, (float)m2, (float)m3, ctx->bin_min + low, peak);
+    if(ctx->entropy){
+        features->entropy = (float)SpectralLog2(m0) / (1 << LOG2_FRAC_BITS) - ((float)plogp / (1 << LOG2_FRAC_BITS)) / m0;
+    }
+    for(uint8_t b=0; b<ctx->n_bands; b++){
+        if(ctx->band_low[b] <= ctx->band_high[b]){
+            uint32_t band = ctx->cumulative_int[ctx->band_high[b] - ctx->bin_min];
+            if(ctx->band_low[b] > ctx->bin_min){
+                band -= ctx->cumulative_int[ctx->band_low[b] - ctx->bin_min - 1];
+            }
+            features->band[b] = ldexpf((float)band, exponent);
+        }
+    }
+}
+
+/*==================[end of file]============================================*/
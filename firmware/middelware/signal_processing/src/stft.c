@@ -0,0 +1,145 @@
+/**
+ * @file stft.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include "stft.h"
+#include "esp_log.h"
+/*==================[macros and definitions]=================================*/
+#define TAG "STFT Module"
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+/**
+ * @brief Calculate the spectrum of the current frame and update the Welch average
+ *
+ * @param stft      Pointer to STFT instance
+ */
+static void STFTFrame(stft_t * stft);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static void STFTFrame(stft_t * stft){
+    uint16_t n_bins = stft->plan.signal_lenght / 2;
+    FFTPlanPower(&stft->plan, stft->frame, stft->power);
+    switch(stft->welch_mode){
+        case STFT_WELCH_OFF:
+        break;
+        case STFT_WELCH_CUMULATIVE:
+            stft->spectra++;
+            float weight = 1.0f / stft->spectra;
+            for(uint16_t i=0; i<n_bins; i++){
+                stft->welch[i] += (stft->power[i] - stft->welch[i]) * weight;
+            }
+        break;
+        case STFT_WELCH_EXPONENTIAL:
+            if(stft->spectra == 0){
+                memcpy(stft->welch, stft->power, n_bins * sizeof(float));
+            }
+            else{
+                for(uint16_t i=0; i<n_bins; i++){
+                    stft->welch[i] += (stft->power[i] - stft->welch[i]) * stft->welch_alpha;
+                }
+            }
+            stft->spectra++;
+        break;
+    }
+    if(stft->func_p != NULL){
+        stft->func_p(stft->power, stft->param_p);
+    }
+}
+
+/*==================[external functions definition]==========================*/
+bool STFTInit(stft_t * stft, stft_config_t * config){
+    memset(stft, 0, sizeof(stft_t));
+    if((config->hop == 0) || (config->hop > config->signal_lenght)){
+        ESP_LOGE(TAG, "Invalid hop: %d", config->hop);
+        return false;
+    }
+    // Out of (0, 1] the exponential average diverges or never updates (NaN also rejected)
+    if((config->welch == STFT_WELCH_EXPONENTIAL) && !((config->welch_alpha > 0.0f) && (config->welch_alpha <= 1.0f))){
+        ESP_LOGE(TAG, "Invalid welch_alpha: %f", config->welch_alpha);
+        return false;
+    }
+    if(!FFTPlanInit(&stft->plan, config->signal_lenght, config->window)){
+        return false;
+    }
+    stft->hop = config->hop;
+    stft->welch_mode = config->welch;
+    stft->welch_alpha = config->welch_alpha;
+    stft->func_p = config->func_p;
+    stft->param_p = config->param_p;
+    stft->frame = malloc(config->signal_lenght * sizeof(float));
+    stft->power = calloc(config->signal_lenght / 2, sizeof(float));
+    if(stft->welch_mode != STFT_WELCH_OFF){
+        stft->welch = calloc(config->signal_lenght / 2, sizeof(float));
+    }
+    if((stft->frame == NULL) || (stft->power == NULL) ||
+       ((stft->welch_mode != STFT_WELCH_OFF) && (stft->welch == NULL))){
+        ESP_LOGE(TAG, "Not enough memory for STFT");
+        STFTDeinit(stft);
+        return false;
+    }
+    return true;
+}
+
+void STFTDeinit(stft_t * stft){
+    FFTPlanDeinit(&stft->plan);
+    free(stft->frame);
+    free(stft->power);
+    free(stft->welch);
+    memset(stft, 0, sizeof(stft_t));
+}
+
+uint16_t STFTPush(stft_t * stft, float * samples, uint16_t lenght){
+    uint16_t n_spectra = 0;
+    uint16_t frame_lenght = stft->plan.signal_lenght;
+    while(lenght > 0){
+        // Copy as many samples as fit in the frame
+        uint16_t n = frame_lenght - stft->fill;
+        if(n > lenght){
+            n = lenght;
+        }
+        memcpy(&stft->frame[stft->fill], samples, n * sizeof(float));
+        stft->fill += n;
+        samples += n;
+        lenght -= n;
+        if(stft->fill == frame_lenght){
+            STFTFrame(stft);
+            n_spectra++;
+            // Keep the overlapping samples for the next frame
+            memmove(stft->frame, &stft->frame[stft->hop], (frame_lenght - stft->hop) * sizeof(float));
+            stft->fill = frame_lenght - stft->hop;
+        }
+    }
+    return n_spectra;
+}
+
+float * STFTPower(stft_t * stft){
+    return stft->power;
+}
+
+float * STFTWelch(stft_t * stft){
+    return stft->welch;
+}
+
+void STFTReset(stft_t * stft){
+    stft->fill = 0;
+    stft->spectra = 0;
+    if(stft->welch != NULL){
+        memset(stft->welch, 0, (stft->plan.signal_lenght / 2) * sizeof(float));
+    }
+}
+
+/*==================[end of file]============================================*/
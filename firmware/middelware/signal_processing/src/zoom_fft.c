@@ -0,0 +1,194 @@
+/**
+ * @file zoom_fft.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "zoom_fft.h"
+#include "esp_dsp.h"
+#include "esp_log.h"
+/*==================[macros and definitions]=================================*/
+#define TAG "Zoom FFT Module"
+#define ZOOM_FFT_MIN_LENGHT     16      /*!< Minimum number of bins */
+#define ZOOM_FFT_CHUNK          16      /*!< Decimated samples processed per chunk */
+#define ZOOM_FFT_TAPS_PER_DECIM 11      /*!< Default filter taps per decimation step (Blackman, ~-74 dB) */
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+/**
+ * @brief Design a Blackman windowed sinc low pass filter with unity DC gain
+ *
+ * @param coeffs    Array to store coefficients
+ * @param lenght    Number of taps
+ * @param cutoff    Cutoff frequency normalized to sample frequency (0 to 0.5)
+ */
+static void ZoomFFTLowPass(float * coeffs, uint16_t lenght, float cutoff);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static void ZoomFFTLowPass(float * coeffs, uint16_t lenght, float cutoff){
+    float sum = 0;
+    float center = (lenght - 1) / 2.0f;
+    dsps_wind_blackman_f32(coeffs, lenght);
+    for(uint16_t i=0; i<lenght; i++){
+        float x = 2 * cutoff * (i - center);
+        if(x != 0){
+            coeffs[i] *= sinf(M_PI * x) / (M_PI * x);
+        }
+        sum += coeffs[i];
+    }
+    for(uint16_t i=0; i<lenght; i++){
+        coeffs[i] /= sum;
+    }
+}
+
+/*==================[external functions definition]==========================*/
+bool ZoomFFTInit(zoom_fft_t * zoom, zoom_fft_config_t * config){
+    memset(zoom, 0, sizeof(zoom_fft_t));
+    uint16_t n = config->fft_lenght;
+    if((n < ZOOM_FFT_MIN_LENGHT) || (n > MAX_SIGNAL_LENGHT) || (!dsp_is_power_of_two(n))){
+        ESP_LOGE(TAG, "Invalid FFT lenght: %d", n);
+        return false;
+    }
+    float band = config->f_high - config->f_low;
+    if((config->f_low < 0) || (band <= 0) || (config->f_high > config->sample_freq / 2)){
+        ESP_LOGE(TAG, "Invalid band: %.2f - %.2f Hz", config->f_low, config->f_high);
+        return false;
+    }
+    // Decimated sample frequency of at least twice the band: the band plus the filter transition
+    float decim = floorf(config->sample_freq / (2 * band));
+    if(decim < 1){
+        decim = 1;
+    }
+    // Filter taps (11 * decim + 1) and mixing buffer (2 * ZOOM_FFT_CHUNK * decim) must fit in memory
+    if(decim > ZOOM_FFT_MAX_DECIM){
+        decim = ZOOM_FFT_MAX_DECIM;
+    }
+    zoom->fft_lenght = n;
+    zoom->decim = decim;
+    zoom->signal_lenght = (uint32_t)zoom->decim * n;
+    zoom->f_center = (config->f_low + config->f_high) / 2;
+    zoom->freq_step = config->sample_freq / zoom->signal_lenght;
+    float bin_low = ceilf((config->f_low - zoom->f_center) / zoom->freq_step) + n / 2;
+    float bin_high = floorf((config->f_high - zoom->f_center) / zoom->freq_step) + n / 2;
+    zoom->bin_low = (bin_low < 0) ? 0 : bin_low;
+    zoom->bin_high = (bin_high > (n - 1)) ? (n - 1) : bin_high;
+    float phase = -2 * M_PI * zoom->f_center / config->sample_freq;
+    zoom->osc_step[0] = cosf(phase);
+    zoom->osc_step[1] = sinf(phase);
+    uint16_t taps = config->fir_lenght;
+    if(taps == 0){
+        taps = ZOOM_FFT_TAPS_PER_DECIM * zoom->decim + 1;
+    }
+    zoom->coeffs = malloc(taps * sizeof(float));
+    float * delay_re = malloc(taps * sizeof(float));
+    float * delay_im = malloc(taps * sizeof(float));
+    zoom->mix = malloc(2 * ZOOM_FFT_CHUNK * zoom->decim * sizeof(float));
+    zoom->decimated = malloc(2 * ZOOM_FFT_CHUNK * sizeof(float));
+    zoom->window = malloc(n * sizeof(float));
+    zoom->data = malloc(2 * n * sizeof(float));
+    // Delay lines are released through fir_re / fir_im
+    zoom->fir_re.delay = delay_re;
+    zoom->fir_im.delay = delay_im;
+    if((zoom->coeffs == NULL) || (delay_re == NULL) || (delay_im == NULL) || (zoom->mix == NULL) ||
+       (zoom->decimated == NULL) || (zoom->window == NULL) || (zoom->data == NULL)){
+        ESP_LOGE(TAG, "Not enough memory for zoom FFT");
+        ZoomFFTDeinit(zoom);
+        return false;
+    }
+    ZoomFFTLowPass(zoom->coeffs, taps, 0.5f / zoom->decim);
+    if((dsps_fird_init_f32(&zoom->fir_re, zoom->coeffs, delay_re, taps, zoom->decim) != ESP_OK) ||
+       (dsps_fird_init_f32(&zoom->fir_im, zoom->coeffs, delay_im, taps, zoom->decim) != ESP_OK)){
+        ESP_LOGE(TAG, "Decimation filter initialization failed");
+        ZoomFFTDeinit(zoom);
+        return false;
+    }
+    FFTWindow(zoom->window, config->window, n);
+    ZoomFFTReset(zoom);
+    return true;
+}
+
+void ZoomFFTDeinit(zoom_fft_t * zoom){
+    free(zoom->coeffs);
+    free(zoom->fir_re.delay);
+    free(zoom->fir_im.delay);
+    free(zoom->mix);
+    free(zoom->decimated);
+    free(zoom->window);
+    free(zoom->data);
+    memset(zoom, 0, sizeof(zoom_fft_t));
+}
+
+void ZoomFFTMagnitude(zoom_fft_t * zoom, const float * signal, float * fft){
+    uint16_t n = zoom->fft_lenght;
+    uint32_t chunk_lenght = (uint32_t)ZOOM_FFT_CHUNK * zoom->decim;
+    float * mix_re = zoom->mix;
+    float * mix_im = &zoom->mix[chunk_lenght];
+    float * dec_re = zoom->decimated;
+    float * dec_im = &zoom->decimated[ZOOM_FFT_CHUNK];
+    float * data = zoom->data;
+    float * window = zoom->window;
+    for(uint16_t chunk=0; chunk<(n / ZOOM_FFT_CHUNK); chunk++){
+        // Shift the band center to 0 Hz
+        float osc_re = zoom->osc[0], osc_im = zoom->osc[1];
+        for(uint32_t i=0; i<chunk_lenght; i++){
+            float x = *signal++;
+            mix_re[i] = x * osc_re;
+            mix_im[i] = x * osc_im;
+            float re = osc_re * zoom->osc_step[0] - osc_im * zoom->osc_step[1];
+            osc_im = osc_re * zoom->osc_step[1] + osc_im * zoom->osc_step[0];
+            osc_re = re;
+        }
+        // Keep the oscillator amplitude at 1 against round-off accumulation
+        float gain = (3.0f - (osc_re * osc_re + osc_im * osc_im)) / 2.0f;
+        zoom->osc[0] = osc_re * gain;
+        zoom->osc[1] = osc_im * gain;
+        // Low pass and decimate
+        dsps_fird_f32(&zoom->fir_re, mix_re, dec_re, ZOOM_FFT_CHUNK);
+        dsps_fird_f32(&zoom->fir_im, mix_im, dec_im, ZOOM_FFT_CHUNK);
+        for(uint16_t i=0; i<ZOOM_FFT_CHUNK; i++){
+            data[0] = dec_re[i] * window[0];
+            data[1] = dec_im[i] * window[0];
+            data += 2;
+            window++;
+        }
+    }
+    dsps_fft2r_fc32(zoom->data, n);
+    dsps_bit_rev_fc32(zoom->data, n);
+    // Reorder from lower (-n/2 bin) to higher frequency (n/2 - 1 bin)
+    float scale = 8.0f / n;
+    for(uint16_t i=0; i<n; i++){
+        uint16_t k = (i + n / 2) & (n - 1);
+        float re = zoom->data[2 * k];
+        float im = zoom->data[2 * k + 1];
+        fft[i] = sqrtf(re * re + im * im) * scale;
+    }
+}
+
+void ZoomFFTFrequency(zoom_fft_t * zoom, float * f){
+    for(uint16_t i=0; i<zoom->fft_lenght; i++){
+        f[i] = zoom->f_center + ((int32_t)i - zoom->fft_lenght / 2) * zoom->freq_step;
+    }
+}
+
+void ZoomFFTReset(zoom_fft_t * zoom){
+    zoom->osc[0] = 1.0f;
+    zoom->osc[1] = 0.0f;
+    memset(zoom->fir_re.delay, 0, zoom->fir_re.N * sizeof(float));
+    memset(zoom->fir_im.delay, 0, zoom->fir_im.N * sizeof(float));
+    zoom->fir_re.pos = 0;
+    zoom->fir_im.pos = 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,31 @@
+/**
+ * @file main.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host tests and benchmarks of the signal processing middleware (see Makefile)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+/*==================[external functions declaration]=========================*/
+int test_iir_filter(void);
+int test_fft_static(void);
+int test_fft(void);
+int test_zoom_fft(void);
+/*==================[external functions definition]==========================*/
+int main(void){
+    int errors = 0;
+    printf("main starts!\n");
+    errors += test_iir_filter();
+    errors += test_fft_static();
+    errors += test_fft();
+    errors += test_zoom_fft();
+    printf("Test done: %s (%d errors)\n", (errors == 0) ? "PASS" : "FAIL", errors);
+    return (errors == 0) ? 0 : 1;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,4 @@
+/* Host stub of esp_attr.h */
+#pragma once
+#define IRAM_ATTR
+#define DRAM_ATTR
@@ -0,0 +1,7 @@
+/* Host stub of esp_log.h: errors and warnings to stderr */
+#pragma once
+#include <stdio.h>
+#define ESP_LOGE(tag, format, ...)	fprintf(stderr, "E %s: " format "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...)	fprintf(stderr, "W %s: " format "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...)
+#define ESP_LOGD(tag, format, ...)
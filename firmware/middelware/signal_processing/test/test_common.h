@@ -0,0 +1,29 @@
+/**
+ * @file test_common.h
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Helpers shared by the host tests of the signal processing middleware
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef TEST_COMMON_H_
+#define TEST_COMMON_H_
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <time.h>
+/*==================[macros]=================================================*/
+#define CHECK(cond)	do{ if(!(cond)){ printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); errors++; } }while(0)
+/*==================[external functions definition]==========================*/
+/**
+ * @brief Monotonic time (us) for the benchmarks
+ */
+static inline double TestTimeUs(void){
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e6 + t.tv_nsec * 1e-3;
+}
+#endif /* #ifndef TEST_COMMON_H_ */
+
+/*==================[end of file]============================================*/
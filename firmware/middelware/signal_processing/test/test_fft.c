@@ -0,0 +1,85 @@
+/**
+ * @file test_fft.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host accuracy test of the fixed point (Q15) FFT plans: magnitude * 2^exponent of
+ * FFTPlanQ15Magnitude() against FFTPlanMagnitude() of the same signal
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <math.h>
+#include "fft.h"
+#include "test_common.h"
+/*==================[macros and definitions]=================================*/
+#define SAMPLE_FREC         1000.0f
+#define MAGNITUDE_ERROR     0.03    /*!< Maximum relative error of the magnitude approximation (fft.h) */
+#define ROUNDING_ERROR      2.0     /*!< Maximum rounding error of the fixed point transform (LSB of the result, fft.h) */
+#define RELATIVE_MIN        200     /*!< Bins where rounding is negligible (LSB of the result) */
+/*==================[internal data definition]===============================*/
+static int16_t signal_q15[MAX_SIGNAL_LENGHT];
+static float signal_f32[MAX_SIGNAL_LENGHT];
+static float fft_f32[MAX_SIGNAL_LENGHT / 2];
+static uint16_t fft_q15[MAX_SIGNAL_LENGHT / 2];
+/*==================[internal functions definition]==========================*/
+static int TestLenght(uint16_t signal_lenght, fft_window_t window, int16_t gain){
+    int errors = 0;
+    fft_plan_t plan;
+    fft_plan_q15_t plan_q15;
+
+    CHECK(FFTPlanInit(&plan, signal_lenght, window));
+    CHECK(FFTPlanQ15Init(&plan_q15, signal_lenght, window));
+    // 12 bit ADC codes: offset, 60 and 150 Hz tones and noise (EMG like), divided by gain
+    for(int i=0; i<signal_lenght; i++){
+        signal_q15[i] = (int16_t)((2048 + 600 * sinf(2 * M_PI * 60 * i / SAMPLE_FREC) + 200 * sinf(2 * M_PI * 150 * i / SAMPLE_FREC)
+            + 40 * (rand() / (float)RAND_MAX - 0.5f)) / gain);
+        signal_f32[i] = signal_q15[i];
+    }
+    FFTPlanMagnitude(&plan, signal_f32, fft_f32);
+    int8_t exponent = FFTPlanQ15Magnitude(&plan_q15, signal_q15, fft_q15);
+    double peak = 0, error = 0, error_rel = 0, rounding = 0;
+    int bins = 0;
+    for(int i=0; i<signal_lenght / 2; i++){
+        peak = fmax(peak, fft_f32[i]);
+    }
+    double lsb = ldexp(1, exponent);
+    for(int i=0; i<signal_lenght / 2; i++){
+        double value = ldexp(fft_q15[i], exponent);
+        double diff = fabs(value - fft_f32[i]);
+        error = fmax(error, diff);
+        // Every bin: relative error of the approximation plus rounding of the transform
+        rounding = fmax(rounding, (diff - MAGNITUDE_ERROR * fft_f32[i]) / lsb);
+        if(fft_f32[i] >= RELATIVE_MIN * lsb){
+            error_rel = fmax(error_rel, diff / fft_f32[i]);
+            bins++;
+        }
+    }
+    CHECK(rounding <= ROUNDING_ERROR);
+    CHECK(error_rel <= MAGNITUDE_ERROR);
+    printf("  %4d points, window %d: exponent %d, max error %.2f%% of peak, %.2f LSB beyond 3%%, max relative error %.2f%% (%d bins >= %d LSB)\n",
+        signal_lenght, window, exponent, 100 * error / peak, rounding, 100 * error_rel, bins, RELATIVE_MIN);
+    FFTPlanDeinit(&plan);
+    FFTPlanQ15Deinit(&plan_q15);
+    return errors;
+}
+/*==================[external functions definition]==========================*/
+int test_fft(void){
+    int errors = 0;
+    printf("fft\n");
+    CHECK(FFTInit());
+    srand(1);
+    for(uint16_t n=64; n<=MAX_SIGNAL_LENGHT; n*=2){
+        errors += TestLenght(n, FFT_WINDOW_HANN, 1);
+    }
+    errors += TestLenght(1024, FFT_WINDOW_NONE, 1);
+    errors += TestLenght(1024, FFT_WINDOW_BLACKMAN, 1);
+    // Small signal (negative exponent)
+    errors += TestLenght(1024, FFT_WINDOW_HANN, 16);
+    return errors;
+}
+
+/*==================[end of file]============================================*/
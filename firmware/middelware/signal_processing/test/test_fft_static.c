@@ -0,0 +1,121 @@
+/**
+ * @file test_fft_static.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test and benchmark of the fixed size FFT kernels (FFTStatic256/512/1024 and
+ * their Q15 versions) against the generic esp-dsp ANSI radix-2 FFT plus bit reversal
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "fft_static.h"
+#include "esp_dsp.h"
+#include "test_common.h"
+/*==================[macros and definitions]=================================*/
+#define MAX_CPLX        1024        /*!< Biggest kernel */
+#define BENCH_REPEAT    20000       /*!< Transforms timed of each size */
+/*==================[internal data definition]===============================*/
+static float signal_f32[2 * MAX_CPLX];
+static float reference_f32[2 * MAX_CPLX];
+static float output_f32[2 * MAX_CPLX];
+static int16_t signal_q15[2 * MAX_CPLX];
+static int16_t reference_q15[2 * MAX_CPLX];
+static int16_t output_q15[2 * MAX_CPLX];
+/*==================[internal functions definition]==========================*/
+static int TestSize(uint16_t n_cplx){
+    int errors = 0;
+    double t0, t1, t2;
+
+    // Two tones plus noise, Q15 values up to half scale
+    for(int i=0; i<2 * n_cplx; i++){
+        signal_f32[i] = 0.3f * sinf(i * 0.37f) + 0.15f * cosf(i * 1.3f) + 0.05f * (rand() / (float)RAND_MAX - 0.5f);
+        signal_q15[i] = (int16_t)lrintf(signal_f32[i] * 32767);
+    }
+    // Float: same result as the ANSI path within float round-off
+    memcpy(reference_f32, signal_f32, sizeof(signal_f32));
+    dsps_fft2r_fc32_ansi(reference_f32, n_cplx);
+    dsps_bit_rev_fc32_ansi(reference_f32, n_cplx);
+    memcpy(output_f32, signal_f32, sizeof(signal_f32));
+    CHECK(FFTStaticTransform(output_f32, n_cplx));
+    double peak = 0, error_f32 = 0;
+    for(int i=0; i<2 * n_cplx; i++){
+        peak = fmax(peak, fabs(reference_f32[i]));
+        error_f32 = fmax(error_f32, fabs(output_f32[i] - reference_f32[i]));
+    }
+    CHECK(error_f32 < 1e-5 * peak);
+    // Q15: scaled by 1/N like dsps_fft2r_sc16 (rounding differs), both compared with the
+    // float transform of the same Q15 input
+    memcpy(reference_q15, signal_q15, sizeof(signal_q15));
+    dsps_fft2r_sc16_ansi(reference_q15, n_cplx);
+    dsps_bit_rev_sc16_ansi(reference_q15, n_cplx);
+    memcpy(output_q15, signal_q15, sizeof(signal_q15));
+    CHECK(FFTStaticTransformQ15(output_q15, n_cplx));
+    double error_q15 = 0, error_ansi_q15 = 0;
+    for(int i=0; i<2 * n_cplx; i++){
+        output_f32[i] = signal_q15[i];
+    }
+    FFTStaticTransform(output_f32, n_cplx);
+    for(int i=0; i<2 * n_cplx; i++){
+        double exact = output_f32[i] / n_cplx;
+        error_q15 = fmax(error_q15, fabs(output_q15[i] - exact));
+        error_ansi_q15 = fmax(error_ansi_q15, fabs(reference_q15[i] - exact));
+    }
+    CHECK((error_q15 <= 2.0) && (error_q15 <= error_ansi_q15));
+    // Throughput (both with results in natural order)
+    t0 = TestTimeUs();
+    for(int r=0; r<BENCH_REPEAT; r++){
+        memcpy(reference_f32, signal_f32, 2 * n_cplx * sizeof(float));
+        dsps_fft2r_fc32_ansi(reference_f32, n_cplx);
+        dsps_bit_rev_fc32_ansi(reference_f32, n_cplx);
+    }
+    t1 = TestTimeUs();
+    for(int r=0; r<BENCH_REPEAT; r++){
+        memcpy(output_f32, signal_f32, 2 * n_cplx * sizeof(float));
+        FFTStaticTransform(output_f32, n_cplx);
+    }
+    t2 = TestTimeUs();
+    double t_ansi = (t1 - t0) / BENCH_REPEAT;
+    double t_static = (t2 - t1) / BENCH_REPEAT;
+    t0 = TestTimeUs();
+    for(int r=0; r<BENCH_REPEAT; r++){
+        memcpy(reference_q15, signal_q15, 2 * n_cplx * sizeof(int16_t));
+        dsps_fft2r_sc16_ansi(reference_q15, n_cplx);
+        dsps_bit_rev_sc16_ansi(reference_q15, n_cplx);
+    }
+    t1 = TestTimeUs();
+    for(int r=0; r<BENCH_REPEAT; r++){
+        memcpy(output_q15, signal_q15, 2 * n_cplx * sizeof(int16_t));
+        FFTStaticTransformQ15(output_q15, n_cplx);
+    }
+    t2 = TestTimeUs();
+    double t_ansi_q15 = (t1 - t0) / BENCH_REPEAT;
+    double t_static_q15 = (t2 - t1) / BENCH_REPEAT;
+    printf("  %4d points: float ANSI %.2f us, static %.2f us (x%.2f), max error %.1e of peak | Q15 ANSI %.2f us (max error %.1f LSB), static %.2f us (x%.2f, max error %.1f LSB)\n",
+        n_cplx, t_ansi, t_static, t_ansi / t_static, error_f32 / peak, t_ansi_q15, error_ansi_q15, t_static_q15, t_ansi_q15 / t_static_q15, error_q15);
+    return errors;
+}
+/*==================[external functions definition]==========================*/
+int test_fft_static(void){
+    int errors = 0;
+    printf("fft_static\n");
+    dsps_fft2r_init_fc32(NULL, MAX_CPLX);
+    dsps_fft2r_init_sc16(NULL, MAX_CPLX);
+    srand(1);
+    errors += TestSize(256);
+    errors += TestSize(512);
+    errors += TestSize(1024);
+    // Sizes without kernel are reported (the caller falls back to esp-dsp)
+    CHECK(!FFTStaticTransform(output_f32, 128));
+    CHECK(!FFTStaticTransformQ15(output_q15, 2048));
+    dsps_fft2r_deinit_fc32();
+    dsps_fft2r_deinit_sc16();
+    return errors;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,102 @@
+/**
+ * @file test_iir_filter.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test and benchmark of the fused IIR cascade: IirFilter() / IirFilterChain()
+ * against dsps_biquad_f32() run once per section over the whole buffer
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include "iir_filter.h"
+#include "esp_dsp.h"
+#include "test_common.h"
+/*==================[macros and definitions]=================================*/
+#define SIGNAL_LENGHT   512         /*!< Samples per block (EMG example window) */
+#define SAMPLE_FREC     1000.0f
+#define BLOCKS          8           /*!< Blocks filtered in the bit identity check (state carried over) */
+#define BENCH_REPEAT    20000       /*!< Blocks filtered in each benchmark */
+/*==================[internal data definition]===============================*/
+static float input[BLOCKS][SIGNAL_LENGHT];
+static float reference[SIGNAL_LENGHT];
+static float output[SIGNAL_LENGHT];
+/*==================[internal functions definition]==========================*/
+/* Previous path: one dsps_biquad_f32() pass over the buffer per section */
+static void SectionBySection(iir_filter_t * filter, float * input_signal, float * output_signal, int16_t signal_lenght){
+    for(uint8_t i=0; i<filter->n_sos; i++){
+        dsps_biquad_f32(input_signal, output_signal, signal_lenght, &filter->coeff[i * IIR_SOS_COEFF], &filter->delay[i * IIR_SOS_DELAY]);
+        input_signal = output_signal;
+    }
+}
+
+static int TestOrder(filter_order_t order){
+    int errors = 0;
+    iir_filter_t hp, lp, hp_ref, lp_ref;
+    iir_filter_config_t hp_config = {.type = IIR_HI_PASS, .sample_frec = SAMPLE_FREC, .cut_frec = 20.0f, .order = order};
+    iir_filter_config_t lp_config = {.type = IIR_LOW_PASS, .sample_frec = SAMPLE_FREC, .cut_frec = 250.0f, .order = order};
+    int differing = 0;
+
+    IirInit(&hp, &hp_config);
+    IirInit(&lp, &lp_config);
+    hp_ref = hp;
+    lp_ref = lp;
+    // Bit identity, single filter and HP + LP chain, with the state carried over between blocks
+    for(int b=0; b<BLOCKS; b++){
+        SectionBySection(&lp_ref, input[b], reference, SIGNAL_LENGHT);
+        IirFilter(&lp, input[b], output, SIGNAL_LENGHT);
+        differing += memcmp(reference, output, sizeof(output)) != 0;
+    }
+    for(int b=0; b<BLOCKS; b++){
+        SectionBySection(&hp_ref, input[b], reference, SIGNAL_LENGHT);
+        SectionBySection(&lp_ref, reference, reference, SIGNAL_LENGHT);
+        IirFilterChain(&hp, &lp, input[b], output, SIGNAL_LENGHT);
+        differing += memcmp(reference, output, sizeof(output)) != 0;
+    }
+    CHECK(differing == 0);
+    // Throughput of the HP + LP pair of the EMG example
+    double t0 = TestTimeUs();
+    for(int r=0; r<BENCH_REPEAT; r++){
+        SectionBySection(&hp_ref, input[r % BLOCKS], reference, SIGNAL_LENGHT);
+        SectionBySection(&lp_ref, reference, reference, SIGNAL_LENGHT);
+    }
+    double t1 = TestTimeUs();
+    for(int r=0; r<BENCH_REPEAT; r++){
+        IirFilter(&hp, input[r % BLOCKS], output, SIGNAL_LENGHT);
+        IirFilter(&lp, output, output, SIGNAL_LENGHT);
+    }
+    double t2 = TestTimeUs();
+    for(int r=0; r<BENCH_REPEAT; r++){
+        IirFilterChain(&hp, &lp, input[r % BLOCKS], output, SIGNAL_LENGHT);
+    }
+    double t3 = TestTimeUs();
+    double t_ref = (t1 - t0) / BENCH_REPEAT;
+    double t_fused = (t2 - t1) / BENCH_REPEAT;
+    double t_chain = (t3 - t2) / BENCH_REPEAT;
+    printf("  order %d HP + LP, %d samples: per section %.2f us, fused %.2f us (x%.2f), chain %.2f us (x%.2f), %d blocks differing\n",
+        order, SIGNAL_LENGHT, t_ref, t_fused, t_ref / t_fused, t_chain, t_ref / t_chain, differing);
+    return errors;
+}
+/*==================[external functions definition]==========================*/
+int test_iir_filter(void){
+    int errors = 0;
+    printf("iir_filter\n");
+    // 12 bit ADC codes
+    srand(1);
+    for(int b=0; b<BLOCKS; b++){
+        for(int i=0; i<SIGNAL_LENGHT; i++){
+            input[b][i] = rand() % 4096;
+        }
+    }
+    errors += TestOrder(ORDER_2);
+    errors += TestOrder(ORDER_4);
+    errors += TestOrder(ORDER_6);
+    errors += TestOrder(ORDER_8);
+    return errors;
+}
+
+/*==================[end of file]============================================*/
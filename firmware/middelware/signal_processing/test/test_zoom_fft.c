@@ -0,0 +1,142 @@
+/**
+ * @file test_zoom_fft.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test of the zoom FFT: tones of the band at the right bins and amplitude, out
+ * of band rejection, state kept between blocks and decimation limit
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "zoom_fft.h"
+#include "test_common.h"
+/*==================[macros and definitions]=================================*/
+#define ECG_SAMPLE_FREC     1000.0f
+#define ECG_BINS            256
+#define ECG_BLOCKS          3
+/*==================[internal data definition]===============================*/
+static float ecg_signal[ECG_BLOCKS * 12 * ECG_BINS];
+static float spectrum[ECG_BLOCKS][ECG_BINS];
+static float frequency[ECG_BINS];
+/*==================[internal functions definition]==========================*/
+/* ECG band (0.5 - 40 Hz) at 1 kHz: two tones on bins and a 100 Hz tone out of the band
+ * (without the decimation filter it would alias to 16.7 Hz) */
+static int TestBand(void){
+    int errors = 0;
+    zoom_fft_t zoom;
+    zoom_fft_config_t config = {.sample_freq = ECG_SAMPLE_FREC, .f_low = 0.5f, .f_high = 40.0f,
+        .fft_lenght = ECG_BINS, .window = FFT_WINDOW_HANN};
+    const int bin_a = ECG_BINS / 2 + 30;
+    const int bin_b = ECG_BINS / 2 - 40;
+
+    CHECK(ZoomFFTInit(&zoom, &config));
+    // Decimated rate of at least twice the band: 1000 / (2 * 39.5) -> 12
+    CHECK((zoom.decim == 12) && (zoom.signal_lenght == 12 * ECG_BINS));
+    CHECK(fabsf(zoom.freq_step - ECG_SAMPLE_FREC / (12 * ECG_BINS)) < 1e-6f);
+    ZoomFFTFrequency(&zoom, frequency);
+    CHECK((frequency[zoom.bin_low] >= 0.5f) && (frequency[zoom.bin_low - 1] < 0.5f));
+    CHECK((frequency[zoom.bin_high] <= 40.0f) && (frequency[zoom.bin_high + 1] > 40.0f));
+    float f_a = frequency[bin_a];
+    float f_b = frequency[bin_b];
+    for(uint32_t i=0; i<ECG_BLOCKS * zoom.signal_lenght; i++){
+        ecg_signal[i] = 1.5f * sinf(2 * M_PI * f_a * i / ECG_SAMPLE_FREC) + 0.3f * sinf(2 * M_PI * f_b * i / ECG_SAMPLE_FREC)
+            + 2.0f * sinf(2 * M_PI * 100.0f * i / ECG_SAMPLE_FREC);
+    }
+    for(int b=0; b<ECG_BLOCKS; b++){
+        ZoomFFTMagnitude(&zoom, &ecg_signal[b * zoom.signal_lenght], spectrum[b]);
+    }
+    // After the first block (filter start up): 2 * A at the tone bins (Hann), nothing else
+    // away from their main lobes (the 100 Hz tone is rejected by the decimation filter)
+    float *last = spectrum[ECG_BLOCKS - 1];
+    float floor = 0;
+    int peak = zoom.bin_low;
+    for(int i=zoom.bin_low; i<=zoom.bin_high; i++){
+        if(last[i] > last[peak]){
+            peak = i;
+        }
+        if((abs(i - bin_a) > 2) && (abs(i - bin_b) > 2)){
+            floor = fmaxf(floor, last[i]);
+        }
+    }
+    CHECK(peak == bin_a);
+    CHECK(fabsf(last[bin_a] - 3.0f) < 0.01f * 3.0f);
+    CHECK(fabsf(last[bin_b] - 0.6f) < 0.01f * 0.6f);
+    CHECK(floor < 1e-3f * 3.0f);
+    // Tones periodic in the block: with the state kept, consecutive spectra are the same
+    float change = 0;
+    for(int i=0; i<ECG_BINS; i++){
+        change = fmaxf(change, fabsf(spectrum[ECG_BLOCKS - 1][i] - spectrum[ECG_BLOCKS - 2][i]));
+    }
+    CHECK(change < 1e-4f * 3.0f);
+    // Reset: the first spectrum (with the filter start up) again
+    float *first = spectrum[1];
+    ZoomFFTReset(&zoom);
+    ZoomFFTMagnitude(&zoom, ecg_signal, first);
+    CHECK(memcmp(first, spectrum[0], sizeof(spectrum[0])) == 0);
+    printf("  0.5 - 40 Hz at 1 kHz, %d bins: decim %d, step %.3f Hz, tones %.2f Hz %.4f (3.0), %.2f Hz %.4f (0.6), floor %.1e, block change %.1e\n",
+        ECG_BINS, zoom.decim, zoom.freq_step, f_a, last[bin_a], f_b, last[bin_b], floor, change);
+    ZoomFFTDeinit(&zoom);
+    return errors;
+}
+
+/* 0.5 Hz band at 48 kHz: decimation limited to ZOOM_FFT_MAX_DECIM */
+static int TestMaxDecim(void){
+    int errors = 0;
+    zoom_fft_t zoom;
+    zoom_fft_config_t config = {.sample_freq = 48000, .f_low = 1000, .f_high = 1000.5f, .fft_lenght = 64, .window = FFT_WINDOW_HANN};
+    float fft[64];
+
+    CHECK(ZoomFFTInit(&zoom, &config));
+    CHECK((zoom.decim == ZOOM_FFT_MAX_DECIM) && (zoom.fir_re.N == 11 * ZOOM_FFT_MAX_DECIM + 1));
+    float *signal = malloc(zoom.signal_lenght * sizeof(float));
+    for(uint32_t i=0; i<zoom.signal_lenght; i++){
+        signal[i] = sinf(2 * M_PI * 1000.25f * i / 48000);
+    }
+    ZoomFFTMagnitude(&zoom, signal, fft);
+    int peak = 0;
+    for(int i=1; i<64; i++){
+        if(fft[i] > fft[peak]){
+            peak = i;
+        }
+    }
+    float f_peak = zoom.f_center + (peak - 32) * zoom.freq_step;
+    CHECK(fabsf(f_peak - 1000.25f) <= zoom.freq_step / 2);
+    printf("  0.5 Hz band at 48 kHz: decim %d (limited from 48000), %d taps, 1000.25 Hz tone at %.3f Hz\n",
+        zoom.decim, zoom.fir_re.N, f_peak);
+    free(signal);
+    ZoomFFTDeinit(&zoom);
+    return errors;
+}
+
+static int TestInvalid(void){
+    int errors = 0;
+    zoom_fft_t zoom;
+    zoom_fft_config_t config = {.sample_freq = 1000, .f_low = 10, .f_high = 20, .fft_lenght = 100, .window = FFT_WINDOW_HANN};
+
+    CHECK(!ZoomFFTInit(&zoom, &config));
+    config.fft_lenght = 64;
+    config.f_high = 600;
+    CHECK(!ZoomFFTInit(&zoom, &config));
+    config.f_high = 10;
+    CHECK(!ZoomFFTInit(&zoom, &config));
+    printf("  invalid lenght and bands rejected\n");
+    return errors;
+}
+/*==================[external functions definition]==========================*/
+int test_zoom_fft(void){
+    int errors = 0;
+    printf("zoom_fft\n");
+    CHECK(FFTInit());
+    errors += TestBand();
+    errors += TestMaxDecim();
+    errors += TestInvalid();
+    return errors;
+}
+
+/*==================[end of file]============================================*/